@@ -0,0 +1,14 @@
+/**
+ * @file compression.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE compression library
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+static inline void zx7_Decompress (void*, const void*) {}
@@ -0,0 +1,16 @@
+/**
+ * @file debug.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE debug library, which prints to standard error
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+#define dbg_printf(...) fprintf(stderr, __VA_ARGS__)
@@ -0,0 +1,24 @@
+/**
+ * @file fileioc.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE file library, where no file ever opens
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t ti_var_t;
+
+static inline ti_var_t ti_Open (const char*, const char*) { return 0; }
+static inline int ti_Close (ti_var_t) { return 0; }
+static inline size_t ti_Read (void*, size_t, size_t, ti_var_t) { return 0; }
+static inline size_t ti_Write (const void*, size_t, size_t, ti_var_t) { return 0; }
+static inline int ti_GetC (ti_var_t) { return -1; }
+static inline int ti_Delete (const char*) { return 0; }
@@ -0,0 +1,43 @@
+/**
+ * @file gfx/gfx.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the images converted for the calculator, which are all empty
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <graphx.h>
+
+#define sizeof_global_palette 0
+
+inline unsigned char global_palette[1];
+inline unsigned char Background_compressed[1];
+inline gfx_sprite_t* Neo_Black_Pawn = nullptr;
+inline gfx_sprite_t* Neo_Black_Knight = nullptr;
+inline gfx_sprite_t* Neo_Black_Bishop = nullptr;
+inline gfx_sprite_t* Neo_Black_Rook = nullptr;
+inline gfx_sprite_t* Neo_Black_Queen = nullptr;
+inline gfx_sprite_t* Neo_Black_King = nullptr;
+inline gfx_sprite_t* Neo_White_Pawn = nullptr;
+inline gfx_sprite_t* Neo_White_Knight = nullptr;
+inline gfx_sprite_t* Neo_White_Bishop = nullptr;
+inline gfx_sprite_t* Neo_White_Rook = nullptr;
+inline gfx_sprite_t* Neo_White_Queen = nullptr;
+inline gfx_sprite_t* Neo_White_King = nullptr;
+inline gfx_sprite_t* Classic_Black_Pawn = nullptr;
+inline gfx_sprite_t* Classic_Black_Knight = nullptr;
+inline gfx_sprite_t* Classic_Black_Bishop = nullptr;
+inline gfx_sprite_t* Classic_Black_Rook = nullptr;
+inline gfx_sprite_t* Classic_Black_Queen = nullptr;
+inline gfx_sprite_t* Classic_Black_King = nullptr;
+inline gfx_sprite_t* Classic_White_Pawn = nullptr;
+inline gfx_sprite_t* Classic_White_Knight = nullptr;
+inline gfx_sprite_t* Classic_White_Bishop = nullptr;
+inline gfx_sprite_t* Classic_White_Rook = nullptr;
+inline gfx_sprite_t* Classic_White_Queen = nullptr;
+inline gfx_sprite_t* Classic_White_King = nullptr;
@@ -0,0 +1,52 @@
+/**
+ * @file graphx.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE graphics library, which draws nothing
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    uint8_t data[1];
+} gfx_sprite_t;
+
+#define GFX_LCD_WIDTH 320
+#define GFX_LCD_HEIGHT 240
+
+#define gfx_buffer 1
+#define gfx_vbuffer ((uint8_t*)0)
+
+static inline void gfx_Begin () {}
+static inline void gfx_End () {}
+static inline void gfx_SetDrawBuffer () {}
+static inline void gfx_BlitBuffer () {}
+static inline void gfx_BlitRectangle (int, int, int, int, int) {}
+static inline void gfx_ZeroScreen () {}
+static inline void gfx_SetPalette (const void*, int, int) {}
+static inline void gfx_SetColor (int) {}
+static inline void gfx_SetTransparentColor (int) {}
+static inline void gfx_SetTextTransparentColor (int) {}
+static inline void gfx_SetTextBGColor (int) {}
+static inline void gfx_SetTextFGColor (int) {}
+static inline void gfx_SetTextScale (int, int) {}
+static inline void gfx_SetTextXY (int, int) {}
+static inline unsigned gfx_GetStringWidth (const char*) { return 0; }
+static inline unsigned gfx_GetCharWidth (char) { return 0; }
+static inline void gfx_PrintChar (char) {}
+static inline void gfx_PrintString (const char*) {}
+static inline void gfx_PrintStringXY (const char*, int, int) {}
+static inline void gfx_PrintInt (int, int) {}
+static inline void gfx_PrintUInt (unsigned, int) {}
+static inline void gfx_Rectangle (int, int, int, int) {}
+static inline void gfx_FillRectangle (int, int, int, int) {}
+static inline void gfx_FillCircle (int, int, int) {}
+static inline void gfx_TransparentSprite (gfx_sprite_t*, int, int) {}
@@ -0,0 +1,33 @@
+/**
+ * @file keypadc.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE keypad library, with no keys ever pressed
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+inline uint8_t kb_Data[8];
+
+enum {
+    kb_KeyClear = 1,
+    kb_KeyDel,
+    kb_Key0,
+    kb_KeyDecPnt,
+    kb_KeySub,
+    kb_KeyMul,
+    kb_KeyDiv,
+    kb_KeyAdd,
+    kb_KeyEnter,
+    kb_Key2nd
+};
+
+static inline void kb_Scan () {}
+
+#define kb_IsDown(key) false
@@ -0,0 +1,17 @@
+/**
+ * @file sys/rtc.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE real time clock
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint32_t rtc_Time () { return uint32_t(time(nullptr)); }
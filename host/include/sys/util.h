@@ -0,0 +1,24 @@
+/**
+ * @file sys/util.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE system utilities
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+static inline void boot_GetDate (uint8_t* day, uint8_t* month, uint16_t* year) {
+    const time_t now = time(nullptr);
+    const struct tm* date = localtime(&now);
+
+    *day = date->tm_mday;
+    *month = date->tm_mon + 1;
+    *year = date->tm_year + 1900;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file ti/getcsc.h
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Host stand-in for the CE scan codes
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+enum {
+    sk_Clear = 1, sk_Chs, sk_Del, sk_Right, sk_Left, sk_0, sk_Down, sk_Up, sk_DecPnt, sk_2nd, sk_Yequ, sk_Sub, sk_Graph, sk_Enter, sk_Window,
+    sk_Trace, sk_Add, sk_9, sk_8, sk_7, sk_6, sk_5, sk_4, sk_3, sk_2, sk_1, sk_Zoom, sk_Tan, sk_Store, sk_Square, sk_Sin, sk_Recip, sk_RParen,
+    sk_Prgm, sk_Power, sk_Mul, sk_Log, sk_Ln, sk_LParen, sk_Div, sk_Cos, sk_Comma, sk_Apps, sk_Math
+};
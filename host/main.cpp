@@ -0,0 +1,144 @@
+/**
+ * @file main.cpp
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Command line driver for testing the engine away from the calculator
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "chess.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace Chess;
+
+Board board (startPosition);
+
+// Counts the leaf nodes of the legal move tree, without stopping at draws by repetition, the fifty-move rule or insufficient material like the game does
+uint64_t Perft (const uint8_t depth) {
+    Move moves[MAX_PSEUDO_LEGAL_MOVES];
+    uint8_t movesAvailable = 0;
+    uint64_t nodes = 0;
+
+    board.UpdateInCheck();
+    board.GeneratePseudoLegalMoves(moves, movesAvailable);
+
+    for (uint8_t index = 0; index < movesAvailable; index++) {
+        if (!board.IsLegal(moves[index])) continue;
+
+        if (depth <= 1) {
+            nodes++;
+            continue;
+        }
+
+        board.MakeMove(moves[index], true);
+        nodes += Perft(depth - 1);
+        board.UnMakeMove(false, true);
+    }
+
+    return nodes;
+}
+
+int Usage () {
+    fprintf(stderr, "usage: chess84 [-n network] bench [depth]\n");
+    fprintf(stderr, "       chess84 [-n network] perft depth [fen]\n");
+    fprintf(stderr, "       chess84 [-n network] eval [fen]     (FENs are read one per line from standard input when none is given)\n");
+
+    return 1;
+}
+
+int main (int argc, char** argv) {
+    int argument = 1;
+
+    if (argument + 1 < argc && !strcmp(argv[argument], "-n")) {
+        if (!board.bot.LoadNeuralNetwork(argv[argument + 1])) {
+            fprintf(stderr, "couldn't load the network %s\n", argv[argument + 1]);
+            return 1;
+        }
+
+        argument += 2;
+    }
+
+    if (argument >= argc) return Usage();
+
+    const char* command = argv[argument++];
+
+    // The node count is the bench signature, which only changes when the search does
+    if (!strcmp(command, "bench")) {
+        const uint8_t depth = argument < argc ? atoi(argv[argument]) : 9;
+        const clock_t startTime = clock();
+        const uint32_t nodes = board.bot.Bench(depth);
+        const uint32_t time = uint32_t((clock() - startTime) / (CLOCKS_PER_SEC / 1000));
+
+        printf("bench %u nodes %u ms %u nps\n", (unsigned)nodes, (unsigned)time, (unsigned)(time ? uint64_t(nodes) * 1000 / time : 0));
+
+        return 0;
+    }
+
+    if (!strcmp(command, "perft")) {
+        if (argument >= argc) return Usage();
+
+        const uint8_t depth = atoi(argv[argument++]);
+
+        // The fullmove number becomes the ply, but the moves before it aren't in the history, so the empty hashes there would read as a threefold repetition
+        if (argument < argc) {
+            board.ImportFen(argv[argument]);
+            board.ply = 0;
+        }
+
+        printf("perft %u %llu\n", (unsigned)depth, (unsigned long long)Perft(depth));
+
+        return 0;
+    }
+
+    if (!strcmp(command, "eval")) {
+        board.bot.randomVariation = false;
+
+        if (argument < argc) {
+            board.ImportFen(argv[argument]);
+            board.UpdateInCheck();
+            printf("%d\n", board.bot.Evaluate());
+
+            return 0;
+        }
+
+        // Positions from standard input are evaluated a batch at a time, which is far faster than one by one
+        static char lines[EvaluationBatch::maxPositions][MAX_FEN_LENGTH];
+        static const char* positions[EvaluationBatch::maxPositions];
+        static eval evaluations[EvaluationBatch::maxPositions];
+        bool inputEnded = false;
+
+        while (!inputEnded) {
+            uint16_t positionsRead = 0;
+
+            while (positionsRead < EvaluationBatch::maxPositions) {
+                if (!fgets(lines[positionsRead], MAX_FEN_LENGTH, stdin)) {
+                    inputEnded = true;
+                    break;
+                }
+
+                lines[positionsRead][strcspn(lines[positionsRead], "\r\n")] = '\0';
+
+                if (lines[positionsRead][0]) {
+                    positions[positionsRead] = lines[positionsRead];
+                    positionsRead++;
+                }
+            }
+
+            if (!board.bot.EvaluateBatch(positions, positionsRead, evaluations)) {
+                fprintf(stderr, "couldn't allocate the batch\n");
+                return 1;
+            }
+
+            for (uint16_t index = 0; index < positionsRead; index++) printf("%s %d\n", positions[index], evaluations[index]);
+        }
+
+        return 0;
+    }
+
+    return Usage();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file batch.cpp
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Definition of batched evaluation
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "chess.hpp"
+
+#ifndef __TICE__
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Chess {
+    void EvaluationBatch::ImportFen (const uint16_t position, const char* fen) {
+        for (uint8_t square = 0; square < 64; square++) squares[square][position] = emptySquare;
+        for (uint8_t linear = 0; linear < 12; linear++) pieceCounts[linear][position] = 0;
+        kingSquares[0][position] = kingSquares[1][position] = OFFBOARD;
+
+        uint8_t index = 0;
+
+        for (uint8_t square = 0; fen[index] != '\0' && fen[index] != ' ' && square < 64; index++, square++) {
+            int8_t digit = fen[index] - '0';
+            piece pieceOnSquare = Piece::empty;
+
+            if (fen[index] == '/') square--;
+            else if (digit >= 0 && digit < 10) square += digit - 1;
+            else {
+                switch (fen[index] | 0x20) { // Lower case, the side is set below
+                    case 'p': pieceOnSquare = Piece::pawn; break;
+                    case 'n': pieceOnSquare = Piece::knight; break;
+                    case 'b': pieceOnSquare = Piece::bishop; break;
+                    case 'r': pieceOnSquare = Piece::rook; break;
+                    case 'q': pieceOnSquare = Piece::queen; break;
+                    case 'k': pieceOnSquare = Piece::king; break;
+                }
+            }
+
+            if (pieceOnSquare == Piece::empty) continue;
+
+            Piece::SetSide(pieceOnSquare, fen[index] >= 'a' ? Piece::black : Piece::white);
+
+            const uint8_t linear = Piece::GetLinearValue(pieceOnSquare);
+            squares[square][position] = linear;
+            if (Piece::IsPiece(pieceOnSquare, Piece::king)) kingSquares[Piece::IsSide(pieceOnSquare, Piece::white)][position] = square;
+            else pieceCounts[linear][position]++;
+        }
+
+        if (fen[index] != '\0') index++;
+        sideToMove[position] = fen[index] == 'w' ? Piece::white : Piece::black;
+
+        castleRights[position] = 0;
+        if (fen[index] != '\0') index++;
+        if (fen[index] != '\0') index++;
+        for (; fen[index] != '\0' && fen[index] != ' '; index++) {
+            if (fen[index] == 'K') castleRights[position] |= 0b1000;
+            if (fen[index] == 'Q') castleRights[position] |= 0b0100;
+            if (fen[index] == 'k') castleRights[position] |= 0b0010;
+            if (fen[index] == 'q') castleRights[position] |= 0b0001;
+        }
+
+        // Skip the en passant square and the fifty move count, neither of which the evaluation looks at
+        for (uint8_t field = 0; field < 2; field++) {
+            if (fen[index] != '\0') index++;
+            for (; fen[index] != '\0' && fen[index] != ' '; index++);
+        }
+        if (fen[index] != '\0') index++;
+
+        // Same conversion as the board's, so the move history limit is hit at the same point
+        uint8_t moveNumber = 0;
+        for (; fen[index] >= '0' && fen[index] <= '9'; index++) moveNumber = moveNumber * 10 + (fen[index] - '0');
+        moveNumber--;
+        ply[position] = uint8_t(moveNumber * 2) + (sideToMove[position] == Piece::black ? 1 : 0);
+    }
+
+    void EvaluationBatch::EvaluatePieceSquares (const uint16_t positions) {
+        uint16_t position = 0;
+
+#if defined(__AVX2__)
+        for (; position + 8 <= positions; position += 8) {
+            __m256i scores = _mm256_setzero_si256();
+            __m256i phases = _mm256_setzero_si256();
+
+            for (uint8_t square = 0; square < 64; square++) {
+                __m256i linear = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(squares[square] + position)));
+
+                scores = _mm256_add_epi32(scores, _mm256_i32gather_epi32(packedPieceSquareValues.scores[square], linear, 4));
+                phases = _mm256_add_epi32(phases, _mm256_i32gather_epi32(packedPieceSquareValues.gamePhases, linear, 4));
+            }
+
+            // The middle game half is sign extended out of the bottom, which leaves exactly the end game half on top
+            __m256i middleGame = _mm256_srai_epi32(_mm256_slli_epi32(scores, 16), 16);
+            __m256i endGame = _mm256_srai_epi32(_mm256_sub_epi32(scores, middleGame), 16);
+
+            _mm256_storeu_si256((__m256i*)(middleGameEvaluations + position), middleGame);
+            _mm256_storeu_si256((__m256i*)(endGameEvaluations + position), endGame);
+            _mm256_storeu_si256((__m256i*)(gamePhases + position), phases);
+        }
+#endif
+
+        for (; position < positions; position++) {
+            int32_t score = 0;
+            int32_t phase = 0;
+
+            for (uint8_t square = 0; square < 64; square++) {
+                score += packedPieceSquareValues.scores[square][squares[square][position]];
+                phase += packedPieceSquareValues.gamePhases[squares[square][position]];
+            }
+
+            middleGameEvaluations[position] = int16_t(uint16_t(score));
+            endGameEvaluations[position] = (score - middleGameEvaluations[position]) >> 16;
+            gamePhases[position] = phase;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * @file batch.hpp
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Declaration of batched evaluation
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+// Batches are meant for offline tuning and data pipelines, which only run on host targets
+#ifndef __TICE__
+
+namespace Chess {
+    /**
+     * Many independent positions laid out structure of arrays, so each square and counter is contiguous across positions and the
+     * piece-square pass can run several positions per instruction
+     */
+    struct EvaluationBatch {
+        static const uint16_t maxPositions = 256;
+        static const uint8_t emptySquare = 12; // Linear piece values run 0-11, so this comes right after them
+
+        uint8_t squares[64][maxPositions]; // Linear piece value on each square, or emptySquare
+        uint8_t pieceCounts[12][maxPositions];
+        uint8_t kingSquares[2][maxPositions]; // 0 = black, 1 = white
+        piece sideToMove[maxPositions];
+        uint8_t castleRights[maxPositions]; // From the highest bit down: white king side, white queen side, black king side, black queen side
+        uint8_t ply[maxPositions];
+
+        // Filled by EvaluatePieceSquares, from white's point of view like the board's own
+        int32_t middleGameEvaluations[maxPositions];
+        int32_t endGameEvaluations[maxPositions];
+        int32_t gamePhases[maxPositions];
+
+        void ImportFen (const uint16_t position, const char* fen);
+        void EvaluatePieceSquares (const uint16_t positions);
+    };
+
+    // Everything LoadBatchPosition overwrites, so the board's own position can be put back once a batch has been evaluated
+    struct LivePosition {
+        piece matrix[64];
+        uint8_t pieceCounts[10]; // Pawns to queens, black then white
+        uint8_t kingSquares[2]; // 0 = black, 1 = white
+        eval middleGameEvaluation;
+        eval endGameEvaluation;
+        uint8_t gamePhase;
+
+        piece sideToMove;
+        bool castleRights[4]; // White king side, white queen side, black king side, black queen side
+        bool castled[2];
+        uint8_t ply;
+        Move lastMove;
+
+        bool blackWins, whiteWins, stalemate, fiftyMoveRule, threefoldRepetition, insufficentMaterial;
+        uint8_t repetitions;
+
+        hash lastZobristHash;
+        hash pawnZobristHash;
+        hash materialZobristHash;
+    };
+
+    /**
+     * The middle game and end game values of each piece on each square packed into one integer (end game in the upper half), with an
+     * all zero entry for an empty square, so a single lookup per square covers both
+     */
+    struct PackedPieceSquareValues {
+        int32_t scores[64][EvaluationBatch::emptySquare + 1];
+        int32_t gamePhases[EvaluationBatch::emptySquare + 1];
+
+        constexpr PackedPieceSquareValues () : scores(), gamePhases() {
+            for (uint8_t square = 0; square < 64; square++) {
+                for (uint8_t linear = 0; linear < EvaluationBatch::emptySquare; linear++) scores[square][linear] = int32_t(uint32_t(int32_t(pieceSquareValues.endGame[linear][square])) << 16) + pieceSquareValues.middleGame[linear][square];
+            }
+
+            for (uint8_t linear = 0; linear < EvaluationBatch::emptySquare; linear++) gamePhases[linear] = Bot::gamePhaseValues[linear % 6];
+        }
+    };
+
+    inline constexpr PackedPieceSquareValues packedPieceSquareValues;
+}
+
+#endif
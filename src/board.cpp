@@ -34,57 +34,9 @@ namespace Chess {
     void Board::MakeMove (const Move& move, const bool ignoreTime) {
         if (matrix[Move::GetStart(move)] == Piece::empty || Move::IsNullMove(move) || CheckGameState()) return;
 
-        if (Piece::IsSide(move.pieceMoved, Piece::white)) {
-            if (Piece::IsPiece(move.pieceMoved, Piece::king)) {
-                if (Move::IsFlag(move, Move::kingCastle)) {
-                    PlacePieceOnSquare(matrix[H1], F1);
-                    PlacePieceOnSquare(Piece::empty, H1);
-                    whiteCastled = true;
-                } else if (Move::IsFlag(move, Move::queenCastle)) {
-                    PlacePieceOnSquare(matrix[A1], D1);
-                    PlacePieceOnSquare(Piece::empty, A1);
-                    whiteCastled = true;
-                }
-
-                whiteKingCastleRights = false;
-                whiteQueenCastleRights = false;
-            } else if (Piece::IsPiece(move.pieceMoved, Piece::rook)) {
-                if (Move::GetStart(move) == H1) whiteKingCastleRights = false;
-                else if (Move::GetStart(move) == A1) whiteQueenCastleRights = false;
-            }
-            if (Piece::IsPiece(move.pieceCaptured, Piece::rook)) {
-                if (Move::GetTarget(move) == H8) blackKingCastleRights = false;
-                else if (Move::GetTarget(move) == A8) blackQueenCastleRights = false;
-            }
-            if (Move::IsFlag(move, Move::enPassant)) {
-                PlacePieceOnSquare(Piece::empty, Move::GetTarget(move) + 8);
-            }
-        } else {
-            if (Piece::IsPiece(move.pieceMoved, Piece::king)) {
-                if (Move::IsFlag(move, Move::kingCastle)) {
-                    PlacePieceOnSquare(matrix[H8], F8);
-                    PlacePieceOnSquare(Piece::empty, H8);
-                    blackCastled = true;
-                } else if (Move::IsFlag(move, Move::queenCastle)) {
-                    PlacePieceOnSquare(matrix[A8], D8);
-                    PlacePieceOnSquare(Piece::empty, A8);
-                    blackCastled = true;
-                }
-                
-                blackKingCastleRights = false;
-                blackQueenCastleRights = false;
-            } else if (Piece::IsPiece(move.pieceMoved, Piece::rook)) {
-                if (Move::GetStart(move) == H8) blackKingCastleRights = false;
-                else if (Move::GetStart(move) == A8) blackQueenCastleRights = false;
-            }
-            if (Piece::IsPiece(move.pieceCaptured, Piece::rook)) {
-                if (Move::GetTarget(move) == H1) whiteKingCastleRights = false;
-                else if (Move::GetTarget(move) == A1) whiteQueenCastleRights = false;
-            }
-            if (Move::IsFlag(move, Move::enPassant)) {
-                PlacePieceOnSquare(Piece::empty, Move::GetTarget(move) - 8);
-            }
-        }
+        // The side moving is only looked at here, the changes that depend on it have it as a constant
+        if (Piece::IsSide(move.pieceMoved, Piece::white)) MakeCastlingAndEnPassantChanges<Piece::white>(move);
+        else MakeCastlingAndEnPassantChanges<Piece::black>(move);
 
         piece pieceMoved = move.pieceMoved;
         if (Move::IsThisPromotion(move, Move::queenPromotion)) {
@@ -146,45 +98,8 @@ namespace Chess {
             UpdateTimeRemainingForMove();
         }
 
-        if (Piece::IsSide(lastMove.pieceMoved, Piece::white)) {
-            if (lastMove.pieceMoved == Piece::whiteKing || lastMove.pieceMoved == Piece::whiteRook) {
-                UpdateWhitesCastleRights();
-            }
-            if (lastMove.pieceCaptured == Piece::blackRook) {
-                UpdateBlacksCastleRights();
-            }
-            if (Move::IsFlag(lastMove, Move::kingCastle)) {
-                PlacePieceOnSquare(matrix[F1], H1);
-                PlacePieceOnSquare(Piece::empty, F1);
-                whiteCastled = true;
-            } else if (Move::IsFlag(lastMove, Move::queenCastle)) {
-                PlacePieceOnSquare(matrix[D1], A1);
-                PlacePieceOnSquare(Piece::empty, D1);
-                whiteCastled = true;
-            } else if (Move::IsFlag(lastMove, Move::enPassant)) {
-                PlacePieceOnSquare(Piece::blackPawn, Move::GetTarget(lastMove) + 8);
-                enPassantSquare = Move::GetTarget(lastMove);
-            }
-        } else {
-            if (lastMove.pieceMoved == Piece::blackKing || lastMove.pieceMoved == Piece::blackRook) {
-                UpdateBlacksCastleRights();
-            }
-            if (lastMove.pieceCaptured == Piece::whiteRook) {
-                UpdateWhitesCastleRights();
-            }
-            if (Move::IsFlag(lastMove, Move::kingCastle)) {
-                PlacePieceOnSquare(matrix[F8], H8);
-                PlacePieceOnSquare(Piece::empty, F8);
-                blackCastled = true;
-            } else if (Move::IsFlag(lastMove, Move::queenCastle)) {
-                PlacePieceOnSquare(matrix[D8], A8);
-                PlacePieceOnSquare(Piece::empty, D8);
-                blackCastled = true;
-            } else if (Move::IsFlag(lastMove, Move::enPassant)) {
-                PlacePieceOnSquare(Piece::whitePawn, Move::GetTarget(lastMove) - 8);
-                enPassantSquare = Move::GetTarget(lastMove);
-            }
-        }
+        if (Piece::IsSide(lastMove.pieceMoved, Piece::white)) UnMakeCastlingAndEnPassantChanges<Piece::white>(lastMove);
+        else UnMakeCastlingAndEnPassantChanges<Piece::black>(lastMove);
 
         PlacePieceOnSquare(lastMove.pieceMoved, Move::GetStart(lastMove));
         PlacePieceOnSquare(lastMove.pieceCaptured, Move::GetTarget(lastMove));
@@ -204,34 +119,144 @@ namespace Chess {
         UpdateThreefoldRepetition();
     }
 
+    template <piece side>
+    void Board::MakeCastlingAndEnPassantChanges (const Move& move) {
+        typedef Piece::SideTraits<side> Side;
+        typedef Piece::SideTraits<Side::opposite> Opponent;
+
+        bool& kingCastleRights = side == Piece::white ? whiteKingCastleRights : blackKingCastleRights;
+        bool& queenCastleRights = side == Piece::white ? whiteQueenCastleRights : blackQueenCastleRights;
+
+        if (Piece::IsPiece(move.pieceMoved, Piece::king)) {
+            if (Move::IsFlag(move, Move::kingCastle)) {
+                PlacePieceOnSquare(matrix[Side::kingRookStart], Side::kingRookTarget);
+                PlacePieceOnSquare(Piece::empty, Side::kingRookStart);
+                (side == Piece::white ? whiteCastled : blackCastled) = true;
+            } else if (Move::IsFlag(move, Move::queenCastle)) {
+                PlacePieceOnSquare(matrix[Side::queenRookStart], Side::queenRookTarget);
+                PlacePieceOnSquare(Piece::empty, Side::queenRookStart);
+                (side == Piece::white ? whiteCastled : blackCastled) = true;
+            }
+
+            kingCastleRights = false;
+            queenCastleRights = false;
+        } else if (Piece::IsPiece(move.pieceMoved, Piece::rook)) {
+            if (Move::GetStart(move) == Side::kingRookStart) kingCastleRights = false;
+            else if (Move::GetStart(move) == Side::queenRookStart) queenCastleRights = false;
+        }
+        if (Piece::IsPiece(move.pieceCaptured, Piece::rook)) {
+            if (Move::GetTarget(move) == Opponent::kingRookStart) (side == Piece::white ? blackKingCastleRights : whiteKingCastleRights) = false;
+            else if (Move::GetTarget(move) == Opponent::queenRookStart) (side == Piece::white ? blackQueenCastleRights : whiteQueenCastleRights) = false;
+        }
+        if (Move::IsFlag(move, Move::enPassant)) {
+            PlacePieceOnSquare(Piece::empty, Move::GetTarget(move) - Side::forward);
+        }
+    }
+
+    template <piece side>
+    void Board::UnMakeCastlingAndEnPassantChanges (const Move& move) {
+        typedef Piece::SideTraits<side> Side;
+        typedef Piece::SideTraits<Side::opposite> Opponent;
+
+        if (move.pieceMoved == Side::king || move.pieceMoved == Side::rook) {
+            if (side == Piece::white) UpdateWhitesCastleRights();
+            else UpdateBlacksCastleRights();
+        }
+        if (move.pieceCaptured == Opponent::rook) {
+            if (side == Piece::white) UpdateBlacksCastleRights();
+            else UpdateWhitesCastleRights();
+        }
+        if (Move::IsFlag(move, Move::kingCastle)) {
+            PlacePieceOnSquare(matrix[Side::kingRookTarget], Side::kingRookStart);
+            PlacePieceOnSquare(Piece::empty, Side::kingRookTarget);
+            (side == Piece::white ? whiteCastled : blackCastled) = true;
+        } else if (Move::IsFlag(move, Move::queenCastle)) {
+            PlacePieceOnSquare(matrix[Side::queenRookTarget], Side::queenRookStart);
+            PlacePieceOnSquare(Piece::empty, Side::queenRookTarget);
+            (side == Piece::white ? whiteCastled : blackCastled) = true;
+        } else if (Move::IsFlag(move, Move::enPassant)) {
+            PlacePieceOnSquare(Opponent::pawn, Move::GetTarget(move) - Side::forward);
+            enPassantSquare = Move::GetTarget(move);
+        }
+    }
+
     void Board::RedoMove () { if (!IsNextMoveNull()) MakeMove(moveHistory[ply]); };
 
     bool Board::IsNextMoveNull () { return Move::IsNullMove(moveHistory[ply]); };
 
     void Board::UpdateInCheck () {
-        inCheck = false;
-        piece playingSide = sideToMove;
-        piece opposingSide = Piece::GetOppositeSide(sideToMove);
+        UpdateAttackMaps();
 
-        sideToMove = opposingSide;
+        inCheck = IsSquareAttacked(sideToMove == Piece::white ? whiteKingSquare : blackKingSquare, Piece::GetOppositeSide(sideToMove));
 
-        GeneratePseudoLegalMoves(pseudoLegalFirstStrikes, pseudoLegalFirstStrikesAvailable, true);
+        if (inCheck && ply) lastMove.check = moveHistory[ply - 1].check = true;
+    }
 
-        uint8_t playingKingSquare = playingSide == Piece::white ? whiteKingSquare : blackKingSquare;
+    void Board::UpdateAttackMaps () {
+        if (attackMapsAreCurrent) return;
 
-        for (uint8_t i = 0; i < pseudoLegalFirstStrikesAvailable && !inCheck; inCheck = Move::GetTarget(pseudoLegalFirstStrikes[i++]) == playingKingSquare);
+        for (uint8_t side = 0; side < 2; side++) {
+            attackedSquares[side] = 0;
+            attackedSquaresCount[side] = 0;
+            for (uint8_t square = 0; square < 64; square++) attackerCounts[side][square] = 0;
+        }
 
-        if (inCheck && ply) {
-            lastMove.check = moveHistory[ply - 1].check = true;
-            uint8_t lastCharacterIndex = 0;
-            for (; lastCharacterIndex < MAX_ALGEBRAIC_NOTATION_LENGTH - 1 && lastMove.algebraicNotation[lastCharacterIndex] != '\0' && lastMove.algebraicNotation[lastCharacterIndex] != '+'; lastCharacterIndex++);
-            lastMove.algebraicNotation[lastCharacterIndex] = moveHistory[ply - 1].algebraicNotation[lastCharacterIndex] = '+';
+        for (uint8_t square = 0; square < 64; square++) {
+            if (matrix[square] == Piece::empty) continue;
+
+            const uint8_t side = Piece::IsSide(matrix[square], Piece::white);
+            const int8_t file = square % 8;
+            const int8_t rank = square / 8;
+            uint8_t firstDirection = 0, lastDirection = 0;
+
+            switch (Piece::GetPiece(matrix[square])) {
+                case Piece::pawn: {
+                    const int8_t attackedRank = side ? rank - 1 : rank + 1;
+
+                    if (attackedRank >= 0 && attackedRank < 8) {
+                        if (file > 0) AddAttack(side, attackedRank * 8 + file - 1);
+                        if (file < 7) AddAttack(side, attackedRank * 8 + file + 1);
+                    }
+                    continue;
+                }
+                case Piece::knight:
+                    for (uint8_t i = 0; i < attackTables.knightTargetCounts[square]; i++) AddAttack(side, attackTables.knightTargets[square][i]);
+                    continue;
+                case Piece::king:
+                    for (uint8_t i = 0; i < attackTables.kingTargetCounts[square]; i++) AddAttack(side, attackTables.kingTargets[square][i]);
+                    continue;
+                case Piece::bishop: firstDirection = 0; lastDirection = 4; break;
+                case Piece::rook: firstDirection = 4; lastDirection = 8; break;
+                case Piece::queen: firstDirection = 0; lastDirection = 8; break;
+            }
+
+            // Sliding pieces attack along each ray up to and including the first piece in the way
+            for (uint8_t i = firstDirection; i < lastDirection; i++) {
+                uint8_t target = square;
+
+                for (uint8_t distance = attackTables.rayLengths[i][square]; distance; distance--) {
+                    target += attackTables.directionSteps[i];
+                    AddAttack(side, target);
+                    if (matrix[target] != Piece::empty) break;
+                }
+            }
         }
 
-        sideToMove = playingSide;
+        attackMapsAreCurrent = true;
+    }
+
+    void Board::AddAttack (const uint8_t side, const uint8_t square) {
+        if (!attackerCounts[side][square]++) {
+            attackedSquares[side] |= uint64_t(1) << square;
+            attackedSquaresCount[side]++;
+        }
     }
 
     bool Board::UpdateInsufficentMaterial () {
+        return insufficentMaterial = bot.ProbeMaterialTable().insufficentMaterial;
+    }
+
+    bool Board::IsInsufficentMaterial () {
         /*
         A game has insufficent material in the following cases:
         1 king             v. 1 king
@@ -242,25 +267,42 @@ namespace Chess {
         1 king + 1 bishop  v. 1 king + 1 bishop
         */
 
-        if (blackPawnsCount || blackRooksCount || blackQueensCount || whitePawnsCount || whiteRooksCount || whiteQueensCount) return insufficentMaterial = false;
+        if (blackPawnsCount || blackRooksCount || blackQueensCount || whitePawnsCount || whiteRooksCount || whiteQueensCount) return false;
         // There are no pawns, rooks, or queens on the board.
-        if (!blackKnightsCount && !whiteKnightsCount && !blackBishopsCount && !whiteBishopsCount) return insufficentMaterial = true; // There are only kings on the board
+        if (!blackKnightsCount && !whiteKnightsCount && !blackBishopsCount && !whiteBishopsCount) return true; // There are only kings on the board
         
         if (!blackBishopsCount && !whiteBishopsCount) {
             // There are no bishops on the board, only knights and kings
-            if (blackKnightsCount == 1 && !whiteKnightsCount) return insufficentMaterial = true;
-            if (whiteKnightsCount == 1 && !blackKnightsCount) return insufficentMaterial = true;
-            if (blackKnightsCount == 1 && whiteKnightsCount == 1) return insufficentMaterial = true;
-            if (blackKnightsCount == 2 && !whiteKnightsCount) return insufficentMaterial = true;
-            if (whiteKnightsCount == 2 && !blackKnightsCount) return insufficentMaterial = true;
+            if (blackKnightsCount == 1 && !whiteKnightsCount) return true;
+            if (whiteKnightsCount == 1 && !blackKnightsCount) return true;
+            if (blackKnightsCount == 1 && whiteKnightsCount == 1) return true;
+            if (blackKnightsCount == 2 && !whiteKnightsCount) return true;
+            if (whiteKnightsCount == 2 && !blackKnightsCount) return true;
         } else if (!blackKnightsCount && !whiteKnightsCount) {
             // There are no knights on the board, only bishops and kings
-            if (blackBishopsCount == 1 && !whiteBishopsCount) return insufficentMaterial = true;
-            if (whiteBishopsCount == 1 && !blackBishopsCount) return insufficentMaterial = true;
-            if (blackBishopsCount == 1 && whiteBishopsCount == 1) return insufficentMaterial = true;
+            if (blackBishopsCount == 1 && !whiteBishopsCount) return true;
+            if (whiteBishopsCount == 1 && !blackBishopsCount) return true;
+            if (blackBishopsCount == 1 && whiteBishopsCount == 1) return true;
+        }
+
+        return false;
+    }
+
+    uint8_t Board::GetPieceCount (const piece pieceToCount) {
+        switch (pieceToCount) {
+            case Piece::blackPawn: return blackPawnsCount;
+            case Piece::blackKnight: return blackKnightsCount;
+            case Piece::blackBishop: return blackBishopsCount;
+            case Piece::blackRook: return blackRooksCount;
+            case Piece::blackQueen: return blackQueensCount;
+            case Piece::whitePawn: return whitePawnsCount;
+            case Piece::whiteKnight: return whiteKnightsCount;
+            case Piece::whiteBishop: return whiteBishopsCount;
+            case Piece::whiteRook: return whiteRooksCount;
+            case Piece::whiteQueen: return whiteQueensCount;
         }
 
-        return insufficentMaterial = false;
+        return 0;
     }
 
     bool Board::DoesBlackHaveInsufficentMaterial () {
@@ -353,7 +395,8 @@ namespace Chess {
         }
     }
 
-    uint8_t Board::GenerateLegalMoves (Move* moves, uint8_t& available, const bool onlyCaptures) {
+    template <Board::GenerationType type>
+    uint8_t Board::GenerateLegalMoves (Move* moves, uint8_t& available) {
         available = 0;
 
         UpdateInsufficentMaterial();
@@ -361,48 +404,13 @@ namespace Chess {
         if (CheckGameState()) return 1;
 
         UpdateInCheck();
-        const bool currentlyInCheck = inCheck;
-
         const uint8_t playingSide = sideToMove;
-        const uint8_t& playingKingSquare = playingSide == Piece::white ? whiteKingSquare : blackKingSquare;
-
-        GeneratePseudoLegalMoves(pseudoLegalMoves, pseudoLegalMovesAvailable, onlyCaptures);
-
-        for (uint8_t i = 0; i < pseudoLegalMovesAvailable; ++i) {
-            MakeMove(pseudoLegalMoves[i], true);
-
-            bool isLegalMove = true;
-            const bool moveIsKingCastle = Move::IsFlag(pseudoLegalMoves[i], Move::kingCastle);
-            const bool moveIsQueenCastle = Move::IsFlag(pseudoLegalMoves[i], Move::queenCastle);
-
-            if (moveIsKingCastle || moveIsQueenCastle) isLegalMove = !currentlyInCheck;
-            
-            if (isLegalMove) {
-                GeneratePseudoLegalMoves(pseudoLegalResponses, pseudoLegalResponsesAvailable, !moveIsKingCastle && !moveIsQueenCastle);
-
-                for (uint8_t j = 0; j < pseudoLegalResponsesAvailable && isLegalMove; ++j) {
-                    isLegalMove = Move::GetTarget(pseudoLegalResponses[j]) != playingKingSquare;
-
-                    if (isLegalMove) {
-                        if (moveIsKingCastle) {
-                            if (playingSide == Piece::white) isLegalMove = Move::GetTarget(pseudoLegalResponses[j]) != F1;
-                            else isLegalMove = Move::GetTarget(pseudoLegalResponses[j]) != F8;
-                        } else if (moveIsQueenCastle) {
-                            if (playingSide == Piece::white) isLegalMove = Move::GetTarget(pseudoLegalResponses[j]) != D1;
-                            else isLegalMove = Move::GetTarget(pseudoLegalResponses[j]) != D8;
-                        }
-                    }
-                }
-            }
 
-            if (isLegalMove) moves[available++] = pseudoLegalMoves[i];
-            
-            UnMakeMove(false, true);
-        }
+        GeneratePseudoLegalMoves<type>(pseudoLegalMoves, pseudoLegalMovesAvailable);
 
-        inCheck = currentlyInCheck;
+        for (uint8_t i = 0; i < pseudoLegalMovesAvailable; ++i) if (IsLegal(pseudoLegalMoves[i])) moves[available++] = pseudoLegalMoves[i];
 
-        if (!onlyCaptures && available == 0) {
+        if (type == allMoves && available == 0) {
             if (!inCheck) stalemate = true;
             else if (playingSide == Piece::black) whiteWins = true;
             else blackWins = true;
@@ -414,156 +422,354 @@ namespace Chess {
         return 0;
     }
 
-    void Board::GeneratePseudoLegalMoves (Move* moves, uint8_t& offset, const bool onlyCaptures) {
-        offset = 0;
+    bool Board::IsPseudoLegal (const Move& move) {
+        const uint8_t start = Move::GetStart(move);
+        const uint8_t target = Move::GetTarget(move);
+        const uint8_t flag = Move::GetFlag(move);
+        const piece opposingSide = Piece::GetOppositeSide(sideToMove);
 
-        for (uint8_t square = 0; square < 64; square++) {
-            if (!Piece::IsSide(matrix[square], sideToMove)) continue;
+        if (Move::IsNullMove(move) || matrix[start] != move.pieceMoved || !Piece::IsSide(move.pieceMoved, sideToMove) || matrix[target] != move.pieceCaptured) return false;
 
-            switch (Piece::GetPiece(matrix[square])) {
-                case Piece::pawn: GeneratePawnMoves(moves, offset, square, onlyCaptures); break;
-                case Piece::knight: GenerateKnightMoves(moves, offset, square, onlyCaptures); break;
-                case Piece::bishop: GenerateBishopMoves(moves, offset, square, onlyCaptures); break;
-                case Piece::rook: GenerateRookMoves(moves, offset, square, onlyCaptures); break;
-                case Piece::queen: GenerateQueenMoves(moves, offset, square, onlyCaptures); break;
-                case Piece::king: GenerateKingMoves(moves, offset, square, onlyCaptures); break;
+        // En passant is the one capture that lands on an empty square
+        if (flag == Move::enPassant) {
+            if (matrix[target] != Piece::empty) return false;
+        } else if (Move::IsCapture(move) ? !Piece::IsSide(matrix[target], opposingSide) : matrix[target] != Piece::empty) return false;
+
+        const int8_t fileDifference = int8_t(target % 8) - int8_t(start % 8);
+        const int8_t rankDifference = int8_t(target / 8) - int8_t(start / 8);
+
+        if (Piece::IsPiece(move.pieceMoved, Piece::pawn)) {
+            const int8_t forward = sideToMove == Piece::white ? -1 : 1;
+
+            if (Move::IsPromotion(move) != (sideToMove == Piece::white ? target < 8 : target >= 56)) return false;
+
+            if (Move::IsCapture(move)) {
+                if (!((attackTables.pawnAttacks[sideToMove == Piece::white][start] >> target) & 1)) return false;
+                if (flag == Move::enPassant) return target == enPassantSquare && Piece::IsSide(matrix[target - 8 * forward], opposingSide) && Piece::IsPiece(matrix[target - 8 * forward], Piece::pawn);
+
+                return flag == Move::capture || Move::IsPromotion(move);
             }
+
+            if (fileDifference) return false;
+            if (flag == Move::doublePawnPush) return rankDifference == 2 * forward && start / 8 == (sideToMove == Piece::white ? 6 : 1) && matrix[start + 8 * forward] == Piece::empty;
+
+            return rankDifference == forward && (flag == Move::quietMove || Move::IsPromotion(move));
+        }
+
+        if (Piece::IsPiece(move.pieceMoved, Piece::king) && (flag == Move::kingCastle || flag == Move::queenCastle)) {
+            if (start != (sideToMove == Piece::white ? E1 : E8)) return false;
+
+            if (flag == Move::kingCastle) return target == start + 2 && (sideToMove == Piece::white ? whiteKingCastleRights : blackKingCastleRights) && matrix[start + 1] == Piece::empty;
+
+            return target == start - 2 && (sideToMove == Piece::white ? whiteQueenCastleRights : blackQueenCastleRights) && matrix[start - 1] == Piece::empty && matrix[start - 3] == Piece::empty;
         }
+
+        if (flag != Move::quietMove && flag != Move::capture) return false;
+
+        const uint8_t direction = attackTables.lineDirections[start][target];
+
+        switch (Piece::GetPiece(move.pieceMoved)) {
+            case Piece::knight: return (attackTables.knightAttacks[start] >> target) & 1;
+            case Piece::king: return (attackTables.kingAttacks[start] >> target) & 1;
+            case Piece::bishop: if (direction >= 4) return false; break; // Which also rules out noDirection
+            case Piece::rook: if (direction < 4 || direction == AttackTables::noDirection) return false; break;
+            case Piece::queen: if (direction == AttackTables::noDirection) return false; break;
+        }
+
+        // Sliding pieces also need every square between the start and the target to be empty
+        const int8_t step = AttackTables::directionSteps[direction];
+
+        for (uint8_t square = start + step; square != target; square += step) if (matrix[square] != Piece::empty) return false;
+
+        return true;
     }
 
-    void Board::GeneratePawnMoves (Move* moves, uint8_t& offset, const uint8_t square, const bool onlyCaptures) {
-        if (matrix[square] == Piece::whitePawn) {
-            if (!onlyCaptures && square >= 16 && matrix[square - 8] == Piece::empty) moves[offset++] = Move(Move::quietMove, square, square - 8, Piece::whitePawn, Piece::empty);
-            if (!onlyCaptures && square >= 48 && square < 56 && matrix[square - 8] == Piece::empty && matrix[square - 16] == Piece::empty) moves[offset++] = Move(Move::doublePawnPush, square, square - 16, Piece::whitePawn, Piece::empty);
-            if (square % 8 != 0 && Piece::IsSide(matrix[square - 9], Piece::black)) {
-                if (square >= 16) moves[offset++] = Move(Move::capture, square, square - 9, Piece::whitePawn, matrix[square - 9]);
-                else {
-                    moves[offset++] = Move(Move::knightPromotionCapture, square, square - 9, Piece::whitePawn, matrix[square - 9]);
-                    moves[offset++] = Move(Move::bishopPromotionCapture, square, square - 9, Piece::whitePawn, matrix[square - 9]);
-                    moves[offset++] = Move(Move::rookPromotionCapture, square, square - 9, Piece::whitePawn, matrix[square - 9]);
-                    moves[offset++] = Move(Move::queenPromotionCapture, square, square - 9, Piece::whitePawn, matrix[square - 9]);
-                }
+    bool Board::IsLegal (const Move& move) {
+        const uint8_t start = Move::GetStart(move);
+        const uint8_t target = Move::GetTarget(move);
+        const piece opposingSide = Piece::GetOppositeSide(sideToMove);
+        const uint8_t kingSquare = sideToMove == Piece::white ? whiteKingSquare : blackKingSquare;
+
+        // The king can't castle out of, through, or into check, all of which the attack maps already show
+        if (Move::IsFlag(move, Move::kingCastle) || Move::IsFlag(move, Move::queenCastle)) {
+            UpdateAttackMaps();
+
+            return !IsSquareAttacked(kingSquare, opposingSide) && !IsSquareAttacked((start + target) / 2, opposingSide) && !IsSquareAttacked(target, opposingSide);
+        }
+
+        const bool isEnPassant = Move::IsFlag(move, Move::enPassant);
+        const bool isKingMove = Piece::IsPiece(move.pieceMoved, Piece::king);
+
+        // Moving a piece that isn't on any line through the king can't expose it, so there's nothing to check unless the king is already attacked
+        if (!isKingMove && !isEnPassant && attackMapsAreCurrent && !IsSquareAttacked(kingSquare, opposingSide) && attackTables.lineDirections[kingSquare][start] == AttackTables::noDirection) return true;
+
+        // Play the move on the squares alone, without any of MakeMove's bookkeeping, and look outwards from the king
+        const uint8_t capturedSquare = isEnPassant ? (start / 8) * 8 + target % 8 : target;
+        const piece capturedPiece = matrix[capturedSquare];
+
+        matrix[capturedSquare] = Piece::empty;
+        matrix[target] = move.pieceMoved;
+        matrix[start] = Piece::empty;
+
+        const bool isLegal = !IsAttackedBy(isKingMove ? target : kingSquare, opposingSide);
+
+        matrix[start] = move.pieceMoved;
+        matrix[target] = move.pieceCaptured;
+        matrix[capturedSquare] = capturedPiece;
+
+        return isLegal;
+    }
+
+    bool Board::GivesCheck (const Move& move) {
+        const uint8_t start = Move::GetStart(move);
+        const uint8_t target = Move::GetTarget(move);
+        const uint8_t kingSquare = sideToMove == Piece::white ? blackKingSquare : whiteKingSquare;
+
+        // Castling, en passant and promotions change more than the two squares the check squares are built around, so they're played on the squares and looked at directly
+        if (Move::IsPromotion(move) || Move::IsFlag(move, Move::kingCastle) || Move::IsFlag(move, Move::queenCastle) || Move::IsFlag(move, Move::enPassant)) {
+            const bool isCastle = Move::IsFlag(move, Move::kingCastle) || Move::IsFlag(move, Move::queenCastle);
+            const uint8_t otherStart = isCastle ? (Move::IsFlag(move, Move::kingCastle) ? start + 3 : start - 4) : Move::IsFlag(move, Move::enPassant) ? (start / 8) * 8 + target % 8 : target; // The rook, or the pawn taken en passant
+            const uint8_t otherTarget = isCastle ? (start + target) / 2 : OFFBOARD;
+            const piece otherPiece = matrix[otherStart];
+            piece pieceOnTarget = move.pieceMoved;
+
+            if (Move::IsPromotion(move)) {
+                pieceOnTarget = Piece::knight + (Move::GetFlag(move) & 0b11); // The promotion flags run knight, bishop, rook, queen
+                Piece::SetSide(pieceOnTarget, sideToMove);
             }
-            if (square % 8 != 7 && Piece::IsSide(matrix[square - 7], Piece::black)) {
-                if (square >= 16) moves[offset++] = Move(Move::capture, square, square - 7, Piece::whitePawn, matrix[square - 7]);
-                else {
-                    moves[offset++] = Move(Move::knightPromotionCapture, square, square - 7, Piece::whitePawn, matrix[square - 7]);
-                    moves[offset++] = Move(Move::bishopPromotionCapture, square, square - 7, Piece::whitePawn, matrix[square - 7]);
-                    moves[offset++] = Move(Move::rookPromotionCapture, square, square - 7, Piece::whitePawn, matrix[square - 7]);
-                    moves[offset++] = Move(Move::queenPromotionCapture, square, square - 7, Piece::whitePawn, matrix[square - 7]);
+
+            matrix[otherStart] = Piece::empty;
+            if (isCastle) matrix[otherTarget] = otherPiece;
+            matrix[target] = pieceOnTarget;
+            matrix[start] = Piece::empty;
+
+            const bool givesCheck = IsAttackedBy(kingSquare, sideToMove);
+
+            matrix[start] = move.pieceMoved;
+            matrix[target] = move.pieceCaptured;
+            if (isCastle) matrix[otherTarget] = Piece::empty;
+            matrix[otherStart] = otherPiece;
+
+            return givesCheck;
+        }
+
+        UpdateCheckSquares();
+
+        if ((checkSquares[Piece::GetPiece(move.pieceMoved) - 1] >> target) & 1) return true;
+
+        // A piece standing between its own slider and the king uncovers a check unless it stays on that line
+        if ((discoveredCheckCandidates >> start) & 1) return attackTables.lineDirections[kingSquare][target] != attackTables.lineDirections[kingSquare][start];
+
+        return false;
+    }
+
+    void Board::UpdateCheckSquares () {
+        if (checkSquaresAreCurrent && checkSquaresSide == sideToMove) return;
+
+        const uint8_t kingSquare = sideToMove == Piece::white ? blackKingSquare : whiteKingSquare;
+
+        for (uint8_t i = 0; i < 6; i++) checkSquares[i] = 0;
+        discoveredCheckCandidates = 0;
+
+        // A pawn checks from the squares one of the king's own pawns would attack
+        checkSquares[Piece::pawn - 1] = attackTables.pawnAttacks[sideToMove != Piece::white][kingSquare];
+        checkSquares[Piece::knight - 1] = attackTables.knightAttacks[kingSquare];
+
+        // Sliders check from every square along each ray up to the first piece, and one of the side's own pieces there is a candidate if the next piece along is a slider of theirs on that ray
+        for (uint8_t i = 0; i < 8; i++) {
+            const uint8_t sliderPiece = i < 4 ? Piece::bishop : Piece::rook;
+            uint8_t square = kingSquare;
+            uint8_t blockingSquare = OFFBOARD;
+
+            for (uint8_t distance = attackTables.rayLengths[i][kingSquare]; distance; distance--) {
+                square += attackTables.directionSteps[i];
+
+                if (blockingSquare == OFFBOARD) {
+                    checkSquares[sliderPiece - 1] |= uint64_t(1) << square;
+                    checkSquares[Piece::queen - 1] |= uint64_t(1) << square;
                 }
-            }
-            if (square % 8 != 0 && enPassantSquare == square - 9 && matrix[square - 1] == Piece::blackPawn) moves[offset++] = Move(Move::enPassant, square, square - 9, Piece::whitePawn, matrix[square - 9]);
-            if (square % 8 != 7 && enPassantSquare == square - 7 && matrix[square + 1] == Piece::blackPawn) moves[offset++] = Move(Move::enPassant, square, square - 7, Piece::whitePawn, matrix[square - 7]);
-            if (!onlyCaptures && square >= 8 && square < 16 && matrix[square - 8] == Piece::empty) {
-                moves[offset++] = Move(Move::queenPromotion, square, square - 8, Piece::whitePawn, Piece::empty);
-                moves[offset++] = Move(Move::rookPromotion, square, square - 8, Piece::whitePawn, Piece::empty);
-                moves[offset++] = Move(Move::bishopPromotion, square, square - 8, Piece::whitePawn, Piece::empty);
-                moves[offset++] = Move(Move::knightPromotion, square, square - 8, Piece::whitePawn, Piece::empty);
-            }
-        } else {
-            if (!onlyCaptures && square < 48 && matrix[square + 8] == Piece::empty) moves[offset++] = Move(Move::quietMove, square, square + 8, Piece::blackPawn, Piece::empty);
-            if (!onlyCaptures && square >= 8 && square < 16 && matrix[square + 8] == Piece::empty && matrix[square + 16] == Piece::empty) moves[offset++] = Move(Move::doublePawnPush, square, square + 16, Piece::blackPawn, Piece::empty);
-            if (square % 8 != 0 && Piece::IsSide(matrix[square + 7], Piece::white)) {
-                if (square < 48) moves[offset++] = Move(Move::capture, square, square + 7, Piece::blackPawn, matrix[square + 7]);
-                else {
-                    moves[offset++] = Move(Move::queenPromotionCapture, square, square + 7, Piece::blackPawn, matrix[square + 7]);
-                    moves[offset++] = Move(Move::rookPromotionCapture, square, square + 7, Piece::blackPawn, matrix[square + 7]);
-                    moves[offset++] = Move(Move::bishopPromotionCapture, square, square + 7, Piece::blackPawn, matrix[square + 7]);
-                    moves[offset++] = Move(Move::knightPromotionCapture, square, square + 7, Piece::blackPawn, matrix[square + 7]);
+
+                if (matrix[square] == Piece::empty) continue;
+                if (blockingSquare != OFFBOARD) {
+                    if (Piece::IsSide(matrix[square], sideToMove) && (Piece::IsPiece(matrix[square], Piece::queen) || Piece::IsPiece(matrix[square], sliderPiece))) discoveredCheckCandidates |= uint64_t(1) << blockingSquare;
+                    break;
                 }
+                if (!Piece::IsSide(matrix[square], sideToMove)) break;
+
+                blockingSquare = square;
             }
-            if (square % 8 != 7 && Piece::IsSide(matrix[square + 9], Piece::white)) {
-                if (square < 48) moves[offset++] = Move(Move::capture, square, square + 9, Piece::blackPawn, matrix[square + 9]);
-                else {
-                    moves[offset++] = Move(Move::queenPromotionCapture, square, square + 9, Piece::blackPawn, matrix[square + 9]);
-                    moves[offset++] = Move(Move::rookPromotionCapture, square, square + 9, Piece::blackPawn, matrix[square + 9]);
-                    moves[offset++] = Move(Move::bishopPromotionCapture, square, square + 9, Piece::blackPawn, matrix[square + 9]);
-                    moves[offset++] = Move(Move::knightPromotionCapture, square, square + 9, Piece::blackPawn, matrix[square + 9]);
+        }
+
+        checkSquaresAreCurrent = true;
+        checkSquaresSide = sideToMove;
+    }
+
+    // Looks outwards from the square instead of using the attack maps, for when the board has been changed without PlacePieceOnSquare
+    bool Board::IsAttackedBy (const uint8_t square, const piece bySide) {
+        const int8_t file = square % 8;
+        const int8_t rank = square / 8;
+        const int8_t pawnRank = bySide == Piece::white ? rank + 1 : rank - 1; // The rank an attacking pawn would be on
+
+        if (pawnRank >= 0 && pawnRank < 8) {
+            if (file > 0 && Piece::IsSide(matrix[pawnRank * 8 + file - 1], bySide) && Piece::IsPiece(matrix[pawnRank * 8 + file - 1], Piece::pawn)) return true;
+            if (file < 7 && Piece::IsSide(matrix[pawnRank * 8 + file + 1], bySide) && Piece::IsPiece(matrix[pawnRank * 8 + file + 1], Piece::pawn)) return true;
+        }
+
+        for (uint8_t i = 0; i < attackTables.knightTargetCounts[square]; i++) {
+            const piece attacker = matrix[attackTables.knightTargets[square][i]];
+            if (Piece::IsSide(attacker, bySide) && Piece::IsPiece(attacker, Piece::knight)) return true;
+        }
+
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t attackerSquare = square;
+
+            for (uint8_t distance = 1; distance <= attackTables.rayLengths[i][square]; distance++) {
+                attackerSquare += attackTables.directionSteps[i];
+
+                const piece attacker = matrix[attackerSquare];
+                if (attacker == Piece::empty) continue;
+
+                if (Piece::IsSide(attacker, bySide)) {
+                    const uint8_t attackerPiece = Piece::GetPiece(attacker);
+                    if (attackerPiece == Piece::queen || attackerPiece == (i < 4 ? Piece::bishop : Piece::rook) || (distance == 1 && attackerPiece == Piece::king)) return true;
                 }
-            }
-            if (square % 8 != 0 && enPassantSquare == square + 7 && matrix[square - 1] == Piece::whitePawn) moves[offset++] = Move(Move::enPassant, square, square + 7, Piece::blackPawn, matrix[square + 7]);
-            if (square % 8 != 7 && enPassantSquare == square + 9 && matrix[square + 1] == Piece::whitePawn) moves[offset++] = Move(Move::enPassant, square, square + 9, Piece::blackPawn, matrix[square + 9]);
-            if (!onlyCaptures && square >= 48 && square < 56 && matrix[square + 8] == Piece::empty) {
-                moves[offset++] = Move(Move::queenPromotion, square, square + 8, Piece::blackPawn, Piece::empty);
-                moves[offset++] = Move(Move::rookPromotion, square, square + 8, Piece::blackPawn, Piece::empty);
-                moves[offset++] = Move(Move::bishopPromotion, square, square + 8, Piece::blackPawn, Piece::empty);
-                moves[offset++] = Move(Move::knightPromotion, square, square + 8, Piece::blackPawn, Piece::empty);
+
+                break;
             }
         }
-    }
 
-    void Board::GenerateKnightMoves (Move* moves, uint8_t& offset, const uint8_t square, const bool onlyCaptures) {
-        AddMoveToSquare(moves, offset, square, 1, -2, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 2, -1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 2, 1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 1, 2, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -1, 2, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -2, 1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -2, -1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -1, -2, onlyCaptures);
+        return false;
     }
 
-    void Board::GenerateBishopMoves (Move* moves, uint8_t& offset, const uint8_t square, const bool onlyCaptures) {
-        for (int8_t i = 1; i <= 7 && !AddMoveToSquare(moves, offset, square, i, i, onlyCaptures); i++);
+    template <Board::GenerationType type>
+    void Board::GeneratePseudoLegalMoves (Move* moves, uint8_t& offset) {
+        offset = 0;
 
-        for (int8_t i = 1; i <= 7 && !AddMoveToSquare(moves, offset, square, -i, i, onlyCaptures); i++);
+        // The side to move is only looked at here, the generators below have it as a constant
+        if (sideToMove == Piece::white) GenerateMovesForSide<Piece::white, type>(moves, offset);
+        else GenerateMovesForSide<Piece::black, type>(moves, offset);
+    }
 
-        for (int8_t i = 1; i <= 7 && !AddMoveToSquare(moves, offset, square, i, -i, onlyCaptures); i++);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateMovesForSide (Move* moves, uint8_t& offset) {
+        for (uint8_t square = 0; square < 64; square++) if (Piece::IsSide(matrix[square], side)) GenerateMovesFromSquare<side, type>(moves, offset, square);
+    }
 
-        for (int8_t i = 1; i <= 7 && !AddMoveToSquare(moves, offset, square, -i, -i, onlyCaptures); i++);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateMovesFromSquare (Move* moves, uint8_t& offset, const uint8_t square) {
+        switch (Piece::GetPiece(matrix[square])) {
+            case Piece::pawn: GeneratePawnMoves<side, type>(moves, offset, square); break;
+            case Piece::knight: GenerateKnightMoves<side, type>(moves, offset, square); break;
+            case Piece::bishop: GenerateBishopMoves<side, type>(moves, offset, square); break;
+            case Piece::rook: GenerateRookMoves<side, type>(moves, offset, square); break;
+            case Piece::queen: GenerateQueenMoves<side, type>(moves, offset, square); break;
+            case Piece::king: GenerateKingMoves<side, type>(moves, offset, square); break;
+        }
     }
 
-    void Board::GenerateRookMoves (Move* moves, uint8_t& offset, const uint8_t square, const bool onlyCaptures) {
-        for (int8_t i = 1; i <= 7 && !AddMoveToSquare(moves, offset, square, i, 0, onlyCaptures); i++);
+    template <piece side, Board::GenerationType type>
+    void Board::GeneratePawnMoves (Move* moves, uint8_t& offset, const uint8_t square) {
+        typedef Piece::SideTraits<side> Side;
+
+        const uint8_t rank = square / 8;
+        const uint8_t file = square % 8;
+        const uint8_t push = square + Side::forward;
+        const bool promotes = push / 8 == Side::promotionRank;
+
+        if (type != captures && !promotes && matrix[push] == Piece::empty) {
+            moves[offset++] = Move(Move::quietMove, square, push, Side::pawn, Piece::empty);
+            if (rank == Side::pawnStartRank && matrix[push + Side::forward] == Piece::empty) moves[offset++] = Move(Move::doublePawnPush, square, push + Side::forward, Side::pawn, Piece::empty);
+        }
+
+        // The capture towards the a-file, then the one towards the h-file
+        for (int8_t direction = -1; direction <= 1 && type != quietMoves; direction += 2) {
+            if ((direction < 0 && file == 0) || (direction > 0 && file == 7)) continue;
+
+            const uint8_t target = push + direction;
+
+            if (Piece::IsSide(matrix[target], Side::opposite)) {
+                if (!promotes) moves[offset++] = Move(Move::capture, square, target, Side::pawn, matrix[target]);
+                else {
+                    moves[offset++] = Move(Move::queenPromotionCapture, square, target, Side::pawn, matrix[target]);
+                    moves[offset++] = Move(Move::rookPromotionCapture, square, target, Side::pawn, matrix[target]);
+                    moves[offset++] = Move(Move::bishopPromotionCapture, square, target, Side::pawn, matrix[target]);
+                    moves[offset++] = Move(Move::knightPromotionCapture, square, target, Side::pawn, matrix[target]);
+                }
+            } else if (enPassantSquare == target && matrix[square + direction] == Piece::SideTraits<Side::opposite>::pawn) moves[offset++] = Move(Move::enPassant, square, target, Side::pawn, matrix[target]);
+        }
+
+        if (type != captures && promotes && matrix[push] == Piece::empty) {
+            moves[offset++] = Move(Move::queenPromotion, square, push, Side::pawn, Piece::empty);
+            moves[offset++] = Move(Move::rookPromotion, square, push, Side::pawn, Piece::empty);
+            moves[offset++] = Move(Move::bishopPromotion, square, push, Side::pawn, Piece::empty);
+            moves[offset++] = Move(Move::knightPromotion, square, push, Side::pawn, Piece::empty);
+        }
+    }
 
-        for (int8_t i = -1; i >= -7 && !AddMoveToSquare(moves, offset, square, i, 0, onlyCaptures); i--);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateKnightMoves (Move* moves, uint8_t& offset, const uint8_t square) {
+        for (uint8_t i = 0; i < attackTables.knightTargetCounts[square]; i++) AddMoveToSquare<side, type>(moves, offset, square, attackTables.knightTargets[square][i]);
+    }
 
-        for (int8_t i = 1; i <= 7 && !AddMoveToSquare(moves, offset, square, 0, i, onlyCaptures); i++);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateBishopMoves (Move* moves, uint8_t& offset, const uint8_t square) {
+        GenerateSlidingMoves<side, type>(moves, offset, square, 0, 4);
+    }
 
-        for (int8_t i = -1; i >= -7 && !AddMoveToSquare(moves, offset, square, 0, i, onlyCaptures); i--);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateRookMoves (Move* moves, uint8_t& offset, const uint8_t square) {
+        GenerateSlidingMoves<side, type>(moves, offset, square, 4, 8);
     }
 
-    void Board::GenerateQueenMoves (Move* moves, uint8_t& offset, const uint8_t square, const bool onlyCaptures) {
-        GenerateBishopMoves(moves, offset, square, onlyCaptures);
-        GenerateRookMoves(moves, offset, square, onlyCaptures);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateQueenMoves (Move* moves, uint8_t& offset, const uint8_t square) {
+        GenerateSlidingMoves<side, type>(moves, offset, square, 0, 8);
     }
 
-    void Board::GenerateKingMoves (Move* moves, uint8_t& offset, const uint8_t square, const bool onlyCaptures) {
-        AddMoveToSquare(moves, offset, square, 0, -1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 1, -1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 1, 0, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 1, 1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, 0, 1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -1, 1, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -1, 0, onlyCaptures);
-        AddMoveToSquare(moves, offset, square, -1, -1, onlyCaptures);
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateSlidingMoves (Move* moves, uint8_t& offset, const uint8_t square, const uint8_t firstDirection, const uint8_t lastDirection) {
+        for (uint8_t i = firstDirection; i < lastDirection; i++) {
+            uint8_t target = square;
 
-        if (!onlyCaptures && matrix[square] == Piece::whiteKing) {
-            if (whiteKingCastleRights && matrix[square + 1] == Piece::empty && matrix[square + 2] == Piece::empty) moves[offset++] = Move(Move::kingCastle, square, square + 2, Piece::whiteKing, Piece::empty);
-            if (whiteQueenCastleRights && matrix[square - 1] == Piece::empty && matrix[square - 2] == Piece::empty && matrix[square - 3] == Piece::empty) moves[offset++] = Move(Move::queenCastle, square, square - 2, Piece::whiteKing, Piece::empty);
-        } else if (!onlyCaptures) {
-            if (blackKingCastleRights && matrix[square + 1] == Piece::empty && matrix[square + 2] == Piece::empty) moves[offset++] = Move(Move::kingCastle, square, square + 2, Piece::blackKing, Piece::empty);
-            if (blackQueenCastleRights && matrix[square - 1] == Piece::empty && matrix[square - 2] == Piece::empty && matrix[square - 3] == Piece::empty) moves[offset++] = Move(Move::queenCastle, square, square - 2, Piece::blackKing, Piece::empty);
+            for (uint8_t distance = attackTables.rayLengths[i][square]; distance; distance--) {
+                target += attackTables.directionSteps[i];
+                if (AddMoveToSquare<side, type>(moves, offset, square, target)) break;
+            }
         }
     }
 
-    int8_t Board::AddMoveToSquare (Move* moves, uint8_t& offset, const uint8_t square, int8_t file, int8_t rank, const bool onlyCaptures) {
-        file += square % 8;
-        rank += square / 8;
+    template <piece side, Board::GenerationType type>
+    void Board::GenerateKingMoves (Move* moves, uint8_t& offset, const uint8_t square) {
+        typedef Piece::SideTraits<side> Side;
+
+        for (uint8_t i = 0; i < attackTables.kingTargetCounts[square]; i++) AddMoveToSquare<side, type>(moves, offset, square, attackTables.kingTargets[square][i]);
 
-        if (file < 0 || file > 7 || rank < 0 || rank > 7) return -1;
+        if (type == captures) return;
 
-        uint8_t target = file + 8 * rank;
+        const bool kingCastleRights = side == Piece::white ? whiteKingCastleRights : blackKingCastleRights;
+        const bool queenCastleRights = side == Piece::white ? whiteQueenCastleRights : blackQueenCastleRights;
+
+        if (kingCastleRights && matrix[square + 1] == Piece::empty && matrix[square + 2] == Piece::empty) moves[offset++] = Move(Move::kingCastle, square, square + 2, Side::king, Piece::empty);
+        if (queenCastleRights && matrix[square - 1] == Piece::empty && matrix[square - 2] == Piece::empty && matrix[square - 3] == Piece::empty) moves[offset++] = Move(Move::queenCastle, square, square - 2, Side::king, Piece::empty);
+    }
 
+    template <piece side, Board::GenerationType type>
+    bool Board::AddMoveToSquare (Move* moves, uint8_t& offset, const uint8_t square, const uint8_t target) {
         if (matrix[target] == Piece::empty) {
-            if (!onlyCaptures) moves[offset++] = Move(Move::quietMove, square, target, matrix[square], matrix[target]);
-            return 0;
-        } else if (!Piece::IsSide(matrix[square], Piece::GetSide(matrix[target]))) moves[offset++] = Move(Move::capture, square, target, matrix[square], matrix[target]);
+            if (type != captures) moves[offset++] = Move(Move::quietMove, square, target, matrix[square], matrix[target]);
+            return false;
+        } else if (type != quietMoves && Piece::IsSide(matrix[target], Piece::SideTraits<side>::opposite)) moves[offset++] = Move(Move::capture, square, target, matrix[square], matrix[target]);
 
-        return 1;
+        return true;
     }
 
+    // The search generates captures and quiet moves on their own, so every version is compiled here for it
+    template uint8_t Board::GenerateLegalMoves<Board::allMoves> (Move* moves, uint8_t& available);
+    template uint8_t Board::GenerateLegalMoves<Board::captures> (Move* moves, uint8_t& available);
+    template void Board::GeneratePseudoLegalMoves<Board::allMoves> (Move* moves, uint8_t& offset);
+    template void Board::GeneratePseudoLegalMoves<Board::captures> (Move* moves, uint8_t& offset);
+    template void Board::GeneratePseudoLegalMoves<Board::quietMoves> (Move* moves, uint8_t& offset);
+
     uint8_t Board::Menu (Option* currentOptions, const uint8_t numberOfOptions) {
         uint8_t key = 0;
 
@@ -726,6 +932,9 @@ namespace Chess {
             case Option::ResetAll: RestoreSettings(); ImportFen(startPosition); whiteStatistics = Statistics(WHITE_ENCODED); blackStatistics = Statistics(BLACK_ENCODED); return 0;
             case Option::UpdateResetBoardOn: resetBoardOn = option->value; return 0;
             case Option::ViewHelp: { uint8_t key = ViewText("HELP", helpPageName, false); option->nameToUse = !key ? FILE_FAILURE : 0; return key; }
+            case Option::UpdateSearchDepth: bot.SetDepthLimits(option->value, bot.maximumDepth); botOptions[0].value = bot.maximumStandardDepth; return 0;
+            case Option::UpdateRandomVariation: bot.randomVariation = option->value; return 0;
+            case Option::UpdateMaximumDepth: bot.SetDepthLimits(bot.maximumStandardDepth, option->value); botOptions[0].value = bot.maximumStandardDepth; botOptions[1].value = bot.maximumDepth; return 0;
             default: return 0;
         }
     }
@@ -1200,6 +1409,9 @@ namespace Chess {
                 break;
         }
 
+        // The material hash has a key for each count of each piece, using the Zobrist keys with the count in place of the square
+        if (matrix[square] != Piece::empty && !Piece::IsPiece(matrix[square], Piece::king)) materialZobristHash ^= zobristKeys.pieceData[GetPieceCount(matrix[square])][Piece::GetLinearValue(matrix[square])];
+
         switch (Piece::GetSide(pieceToPlace)) {
             case Piece::black:
                 switch (pieceToPlace) {
@@ -1221,25 +1433,172 @@ namespace Chess {
                 break;
         }
 
+        if (pieceToPlace != Piece::empty && !Piece::IsPiece(pieceToPlace, Piece::king)) materialZobristHash ^= zobristKeys.pieceData[GetPieceCount(pieceToPlace) - 1][Piece::GetLinearValue(pieceToPlace)];
+
+        if (Piece::IsPiece(matrix[square], Piece::pawn)) pawnZobristHash ^= zobristKeys.pieceData[square][Piece::GetLinearValue(matrix[square])];
+        if (Piece::IsPiece(pieceToPlace, Piece::pawn)) pawnZobristHash ^= zobristKeys.pieceData[square][Piece::GetLinearValue(pieceToPlace)];
+
+        if (matrix[square] != Piece::empty) {
+            middleGameEvaluation -= pieceSquareValues.middleGame[Piece::GetLinearValue(matrix[square])][square];
+            endGameEvaluation -= pieceSquareValues.endGame[Piece::GetLinearValue(matrix[square])][square];
+            gamePhase -= Bot::gamePhaseValues[Piece::GetPiece(matrix[square]) - 1];
+        }
+
+        if (pieceToPlace != Piece::empty) {
+            middleGameEvaluation += pieceSquareValues.middleGame[Piece::GetLinearValue(pieceToPlace)][square];
+            endGameEvaluation += pieceSquareValues.endGame[Piece::GetLinearValue(pieceToPlace)][square];
+            gamePhase += Bot::gamePhaseValues[Piece::GetPiece(pieceToPlace) - 1];
+        }
+
         switch (pieceToPlace) {
             case Piece::blackKing: blackKingSquare = square; blackKingFile = square % 8; blackKingRank = square / 8; break;
             case Piece::whiteKing: whiteKingSquare = square; whiteKingFile = square % 8; whiteKingRank = square / 8; break;
         }
 
+#ifndef __TICE__
+        if (bot.network.isLoaded) UpdateAccumulators(matrix[square], pieceToPlace, square);
+#endif
+
         matrix[square] = pieceToPlace;
+        attackMapsAreCurrent = checkSquaresAreCurrent = false;
+    }
+
+#ifndef __TICE__
+    void Board::UpdateAccumulators (const piece removedPiece, const piece placedPiece, const uint8_t square) {
+        for (uint8_t perspective = 0; perspective < 2; perspective++) {
+            piece side = perspective ? Piece::white : Piece::black;
+
+            // Every feature is relative to the king, so moving it means the perspective is rebuilt the next time it's evaluated
+            if ((Piece::IsPiece(removedPiece, Piece::king) && Piece::IsSide(removedPiece, side)) || (Piece::IsPiece(placedPiece, Piece::king) && Piece::IsSide(placedPiece, side))) accumulator.isStale[perspective] = true;
+            if (accumulator.isStale[perspective]) continue;
+
+            uint8_t kingSquare = perspective ? whiteKingSquare : blackKingSquare;
+
+            if (removedPiece != Piece::empty && !Piece::IsPiece(removedPiece, Piece::king)) bot.network.SubtractFeature(accumulator.values[perspective], NeuralNetwork::GetFeatureIndex(side, kingSquare, removedPiece, square));
+            if (placedPiece != Piece::empty && !Piece::IsPiece(placedPiece, Piece::king)) bot.network.AddFeature(accumulator.values[perspective], NeuralNetwork::GetFeatureIndex(side, kingSquare, placedPiece, square));
+        }
     }
 
+    void Board::RefreshAccumulator (const uint8_t perspective) {
+        piece side = perspective ? Piece::white : Piece::black;
+        uint8_t kingSquare = perspective ? whiteKingSquare : blackKingSquare;
+
+        bot.network.ResetAccumulator(accumulator.values[perspective]);
+        for (uint8_t square = 0; square < 64; square++) if (matrix[square] != Piece::empty && !Piece::IsPiece(matrix[square], Piece::king)) bot.network.AddFeature(accumulator.values[perspective], NeuralNetwork::GetFeatureIndex(side, kingSquare, matrix[square], square));
+
+        accumulator.isStale[perspective] = false;
+    }
+
+    void Board::LoadBatchPosition (const EvaluationBatch& batch, const uint16_t position) {
+        pawnZobristHash = materialZobristHash = 0;
+
+        for (uint8_t square = 0; square < 64; square++) {
+            const uint8_t linear = batch.squares[square][position];
+
+            if (linear == EvaluationBatch::emptySquare) matrix[square] = Piece::empty;
+            else matrix[square] = linear < 6 ? Piece::black | (linear + 1) : Piece::white | (linear - 5);
+
+            if (Piece::IsPiece(matrix[square], Piece::pawn)) pawnZobristHash ^= zobristKeys.pieceData[square][linear];
+        }
+
+        for (uint8_t linear = 0; linear < 12; linear++) for (uint8_t count = 0; count < batch.pieceCounts[linear][position]; count++) materialZobristHash ^= zobristKeys.pieceData[count][linear];
+
+        blackPawnsCount = batch.pieceCounts[0][position]; blackKnightsCount = batch.pieceCounts[1][position]; blackBishopsCount = batch.pieceCounts[2][position]; blackRooksCount = batch.pieceCounts[3][position]; blackQueensCount = batch.pieceCounts[4][position];
+        whitePawnsCount = batch.pieceCounts[6][position]; whiteKnightsCount = batch.pieceCounts[7][position]; whiteBishopsCount = batch.pieceCounts[8][position]; whiteRooksCount = batch.pieceCounts[9][position]; whiteQueensCount = batch.pieceCounts[10][position];
+
+        if (batch.kingSquares[0][position] != OFFBOARD) { blackKingSquare = batch.kingSquares[0][position]; blackKingFile = blackKingSquare % 8; blackKingRank = blackKingSquare / 8; }
+        if (batch.kingSquares[1][position] != OFFBOARD) { whiteKingSquare = batch.kingSquares[1][position]; whiteKingFile = whiteKingSquare % 8; whiteKingRank = whiteKingSquare / 8; }
+
+        middleGameEvaluation = batch.middleGameEvaluations[position];
+        endGameEvaluation = batch.endGameEvaluations[position];
+        gamePhase = batch.gamePhases[position];
+
+        sideToMove = batch.sideToMove[position];
+        whiteKingCastleRights = batch.castleRights[position] & 0b1000;
+        whiteQueenCastleRights = batch.castleRights[position] & 0b0100;
+        blackKingCastleRights = batch.castleRights[position] & 0b0010;
+        blackQueenCastleRights = batch.castleRights[position] & 0b0001;
+        ply = batch.ply[position];
+
+        // Exactly what a freshly imported position starts with
+        lastMove = Move();
+        blackCastled = whiteCastled = false;
+        blackWins = whiteWins = stalemate = fiftyMoveRule = threefoldRepetition = false;
+        repetitions = 0;
+        accumulator.isStale[0] = accumulator.isStale[1] = true;
+        attackMapsAreCurrent = checkSquaresAreCurrent = false;
+
+        UpdateInsufficentMaterial();
+    }
+
+    void Board::SaveLivePosition (LivePosition& saved) {
+        for (uint8_t square = 0; square < 64; square++) saved.matrix[square] = matrix[square];
+
+        saved.pieceCounts[0] = blackPawnsCount; saved.pieceCounts[1] = blackKnightsCount; saved.pieceCounts[2] = blackBishopsCount; saved.pieceCounts[3] = blackRooksCount; saved.pieceCounts[4] = blackQueensCount;
+        saved.pieceCounts[5] = whitePawnsCount; saved.pieceCounts[6] = whiteKnightsCount; saved.pieceCounts[7] = whiteBishopsCount; saved.pieceCounts[8] = whiteRooksCount; saved.pieceCounts[9] = whiteQueensCount;
+        saved.kingSquares[0] = blackKingSquare;
+        saved.kingSquares[1] = whiteKingSquare;
+        saved.middleGameEvaluation = middleGameEvaluation;
+        saved.endGameEvaluation = endGameEvaluation;
+        saved.gamePhase = gamePhase;
+
+        saved.sideToMove = sideToMove;
+        saved.castleRights[0] = whiteKingCastleRights; saved.castleRights[1] = whiteQueenCastleRights; saved.castleRights[2] = blackKingCastleRights; saved.castleRights[3] = blackQueenCastleRights;
+        saved.castled[0] = blackCastled;
+        saved.castled[1] = whiteCastled;
+        saved.ply = ply;
+        saved.lastMove = lastMove;
+
+        saved.blackWins = blackWins; saved.whiteWins = whiteWins; saved.stalemate = stalemate; saved.fiftyMoveRule = fiftyMoveRule; saved.threefoldRepetition = threefoldRepetition; saved.insufficentMaterial = insufficentMaterial;
+        saved.repetitions = repetitions;
+
+        saved.lastZobristHash = lastZobristHash;
+        saved.pawnZobristHash = pawnZobristHash;
+        saved.materialZobristHash = materialZobristHash;
+    }
+
+    void Board::RestoreLivePosition (const LivePosition& saved) {
+        for (uint8_t square = 0; square < 64; square++) matrix[square] = saved.matrix[square];
+
+        blackPawnsCount = saved.pieceCounts[0]; blackKnightsCount = saved.pieceCounts[1]; blackBishopsCount = saved.pieceCounts[2]; blackRooksCount = saved.pieceCounts[3]; blackQueensCount = saved.pieceCounts[4];
+        whitePawnsCount = saved.pieceCounts[5]; whiteKnightsCount = saved.pieceCounts[6]; whiteBishopsCount = saved.pieceCounts[7]; whiteRooksCount = saved.pieceCounts[8]; whiteQueensCount = saved.pieceCounts[9];
+        blackKingSquare = saved.kingSquares[0]; blackKingFile = blackKingSquare % 8; blackKingRank = blackKingSquare / 8;
+        whiteKingSquare = saved.kingSquares[1]; whiteKingFile = whiteKingSquare % 8; whiteKingRank = whiteKingSquare / 8;
+        middleGameEvaluation = saved.middleGameEvaluation;
+        endGameEvaluation = saved.endGameEvaluation;
+        gamePhase = saved.gamePhase;
+
+        sideToMove = saved.sideToMove;
+        whiteKingCastleRights = saved.castleRights[0]; whiteQueenCastleRights = saved.castleRights[1]; blackKingCastleRights = saved.castleRights[2]; blackQueenCastleRights = saved.castleRights[3];
+        blackCastled = saved.castled[0];
+        whiteCastled = saved.castled[1];
+        ply = saved.ply;
+        lastMove = saved.lastMove;
+
+        blackWins = saved.blackWins; whiteWins = saved.whiteWins; stalemate = saved.stalemate; fiftyMoveRule = saved.fiftyMoveRule; threefoldRepetition = saved.threefoldRepetition; insufficentMaterial = saved.insufficentMaterial;
+        repetitions = saved.repetitions;
+
+        lastZobristHash = saved.lastZobristHash;
+        pawnZobristHash = saved.pawnZobristHash;
+        materialZobristHash = saved.materialZobristHash;
+
+        // The accumulator and attack maps were built for the batch's positions, so they're rebuilt from the restored one when next needed
+        accumulator.isStale[0] = accumulator.isStale[1] = true;
+        attackMapsAreCurrent = checkSquaresAreCurrent = false;
+    }
+#endif
+
     hash Board::GenerateZobristHash () {
         hash hash = 0;
 
-        for (uint8_t square = 0; square < 64; square++) if (matrix[square] != Piece::empty) hash ^= zobristPieceDataKeys[square][Piece::GetLinearValue(matrix[square])];
+        for (uint8_t square = 0; square < 64; square++) if (matrix[square] != Piece::empty) hash ^= zobristKeys.pieceData[square][Piece::GetLinearValue(matrix[square])];
         if (enPassantSquare != OFFBOARD) {
             bool blackIsAbleToCaptureEnPassant = sideToMove == Piece::black && ((enPassantSquare % 8 != 0 && matrix[enPassantSquare - 9] == Piece::blackPawn) || (enPassantSquare % 8 != 7 && matrix[enPassantSquare - 7] == Piece::blackPawn));
             bool whiteIsAbleToCaptureEnPassant = sideToMove == Piece::white && ((enPassantSquare % 8 != 7 && matrix[enPassantSquare + 9] == Piece::whitePawn) || (enPassantSquare % 8 != 0 && matrix[enPassantSquare + 7] == Piece::whitePawn));
-            if (blackIsAbleToCaptureEnPassant || whiteIsAbleToCaptureEnPassant) hash ^= zobristPieceDataKeys[enPassantSquare][12];
+            if (blackIsAbleToCaptureEnPassant || whiteIsAbleToCaptureEnPassant) hash ^= zobristKeys.pieceData[enPassantSquare][12];
         }
-        if (sideToMove == Piece::white) hash ^= zobristSideToMoveKey;
-        hash ^= zobristCastleRightsKeys[(blackKingCastleRights << 0) | (blackQueenCastleRights << 1) | (whiteKingCastleRights << 2) | (whiteQueenCastleRights << 3)];
+        if (sideToMove == Piece::white) hash ^= zobristKeys.sideToMove;
+        hash ^= zobristKeys.castleRights[(blackKingCastleRights << 0) | (blackQueenCastleRights << 1) | (whiteKingCastleRights << 2) | (whiteQueenCastleRights << 3)];
 
         return hash;
     }
@@ -1289,8 +1648,6 @@ namespace Chess {
     }
 
     void Board::ImportFen (const char* fen) {
-        srandom(rtc_Time());
-
         uint8_t startingFenLength = 0;
         for (; fen[startingFenLength] != '\0'; startingFen[startingFenLength] = fen[startingFenLength], startingFenLength++);
         for (; startingFenLength < MAX_FEN_LENGTH; startingFen[startingFenLength++] = '\0');
@@ -1336,6 +1693,7 @@ namespace Chess {
         else sideToMove = Piece::black;
 
         blackKingCastleRights = blackQueenCastleRights = whiteKingCastleRights = whiteQueenCastleRights = false;
+        blackCastled = whiteCastled = false;
         initialBlackKingCastleRights = initialBlackQueenCastleRights = initialWhiteKingCastleRights = initialWhiteQueenCastleRights = false;
         
         for (index += 2; index < length && fen[index] != ' '; index++) {
@@ -1373,6 +1731,8 @@ namespace Chess {
         initalInCheck = inCheck;
         UpdateInsufficentMaterial();
         lastZobristHash = initialZobristHash = GenerateZobristHash();
+
+        bot.Clear();
     }
 
     void Board::ExportFen (char* fen) {
@@ -1442,6 +1802,7 @@ namespace Chess {
                 moves[i].algebraicNotation[index++] = 'O';
                 moves[i].algebraicNotation[index++] = '-';
                 moves[i].algebraicNotation[index++] = 'O';
+                if ((moves[i].check = GivesCheck(moves[i]))) moves[i].algebraicNotation[index++] = '+';
                 continue;
             } else if (Move::IsFlag(moves[i], Move::queenCastle)) {
                 moves[i].algebraicNotation[index++] = 'O';
@@ -1449,6 +1810,7 @@ namespace Chess {
                 moves[i].algebraicNotation[index++] = 'O';
                 moves[i].algebraicNotation[index++] = '-';
                 moves[i].algebraicNotation[index++] = 'O';
+                if ((moves[i].check = GivesCheck(moves[i]))) moves[i].algebraicNotation[index++] = '+';
                 continue;
             }
 
@@ -1509,6 +1871,8 @@ namespace Chess {
                     moves[i].algebraicNotation[index++] = 'K';
                 }
             }
+
+            if ((moves[i].check = GivesCheck(moves[i]))) moves[i].algebraicNotation[index++] = '+';
         }
     }
 
@@ -2250,5 +2614,10 @@ namespace Chess {
         saveOptions[6].value = savePGNOnGameOver = false;
 
         resetOptions[6].value = resetBoardOn = 0;
+
+        bot.SetDepthLimits(DEFAULT_MAXIMUM_STANDARD_DEPTH, DEFAULT_MAXIMUM_DEPTH);
+        botOptions[0].value = bot.maximumStandardDepth;
+        botOptions[1].value = bot.maximumDepth;
+        botOptions[2].value = bot.randomVariation = true;
     }
 }
\ No newline at end of file
@@ -12,34 +12,211 @@
 #include "chess.hpp"
 
 namespace Chess {
+    bool Bot::SetDepthLimits (uint8_t standardDepth, uint8_t depth) {
+        if (depth < 2) depth = 2;
+        else if (depth > MAX_SEARCH_DEPTH) depth = MAX_SEARCH_DEPTH;
+        if (standardDepth < 1) standardDepth = 1;
+        else if (standardDepth > depth) standardDepth = depth;
+
+        // Check and singular extensions can give back the ply every move takes off, so the depth left at the deepest ply can reach the standard depth plus the maximum depth, which has to fit in the search's int8_t
+        if (standardDepth > INT8_MAX - depth) standardDepth = INT8_MAX - depth;
+
+        if (depth != maximumDepth) {
+            const size_t legalMoveMemorySize = sizeof(LegalMoveMemory) * depth;
+            const size_t killerMovesSize = sizeof(Move[2]) * depth;
+            const size_t principalVariationSize = sizeof(Move) * (depth * (depth + 1) / 2);
+            const size_t iterationStatisticsSize = sizeof(SearchStatistics) * depth;
+            const size_t principalVariationLengthSize = sizeof(uint8_t) * depth;
+
+            uint8_t* arena = (uint8_t*)malloc(legalMoveMemorySize + killerMovesSize + principalVariationSize + iterationStatisticsSize + principalVariationLengthSize);
+            if (arena == nullptr) return false; // Keeps the previous stacks if there isn't enough memory for the new ones
+
+            free(searchStack);
+
+            searchStack = arena;
+            legalMoveMemory = (LegalMoveMemory*)arena;
+            killerMoves = (Move(*)[2])(arena + legalMoveMemorySize);
+            principalVariation = (Move*)(arena + legalMoveMemorySize + killerMovesSize);
+            iterationStatistics = (SearchStatistics*)(arena + legalMoveMemorySize + killerMovesSize + principalVariationSize);
+            principalVariationLength = arena + legalMoveMemorySize + killerMovesSize + principalVariationSize + iterationStatisticsSize;
+            maximumDepth = depth;
+            iterationsCompleted = 0;
+
+            // The calculator's heap isn't cleared, so every ply's memory is constructed to start from its defaults, with no move excluded or played
+            for (uint8_t ply = 0; ply < maximumDepth; ply++) {
+                new (legalMoveMemory + ply) LegalMoveMemory();
+                killerMoves[ply][0] = killerMoves[ply][1] = Move();
+            }
+            ClearPrincipalVariation();
+        }
+
+        maximumStandardDepth = standardDepth;
+
+        return true;
+    }
+
+    void SearchStatistics::Add (const SearchStatistics& other) {
+        if (other.depth > depth) depth = other.depth;
+        if (other.selectiveDepth > selectiveDepth) selectiveDepth = other.selectiveDepth;
+        nodes += other.nodes;
+        quiescentNodes += other.quiescentNodes;
+        transpositionProbes += other.transpositionProbes;
+        transpositionHits += other.transpositionHits;
+        transpositionCutoffs += other.transpositionCutoffs;
+        nullMoveAttempts += other.nullMoveAttempts;
+        nullMoveCutoffs += other.nullMoveCutoffs;
+        lateMoveReductionResearches += other.lateMoveReductionResearches;
+        futilityPrunes += other.futilityPrunes;
+        reverseFutilityPrunes += other.reverseFutilityPrunes;
+        razorPrunes += other.razorPrunes;
+        lateMovePrunes += other.lateMovePrunes;
+        historyPrunes += other.historyPrunes;
+        probCutPrunes += other.probCutPrunes;
+        singularExtensions += other.singularExtensions;
+        multiCutPrunes += other.multiCutPrunes;
+        internalIterativeReductions += other.internalIterativeReductions;
+        mateDistancePrunes += other.mateDistancePrunes;
+        aspirationResearches += other.aspirationResearches;
+        deltaPrunes += other.deltaPrunes;
+        badCapturePrunes += other.badCapturePrunes;
+        evaluationCacheProbes += other.evaluationCacheProbes;
+        evaluationCacheHits += other.evaluationCacheHits;
+        lazyEvaluations += other.lazyEvaluations;
+        failHigh += other.failHigh;
+        failHighFirst += other.failHighFirst;
+        time += other.time;
+    }
+
+    uint32_t SearchStatistics::NodesPerSecond () const {
+        return time ? uint32_t(uint64_t(nodes) * 1000 / time) : 0;
+    }
+
+    int8_t SearchStatistics::MateInMoves () const {
+        if (evaluation >= MATE_EVALUATION_THRESHOLD) return int8_t((HIGHEST_EVALUATION - evaluation + 1) / 2);
+        if (evaluation <= -MATE_EVALUATION_THRESHOLD) return -int8_t((evaluation - LOWEST_EVALUATION) / 2);
+
+        return 0;
+    }
+
+    void SearchStatistics::Log (const char* type) const {
+        dbg_printf("{\"type\":\"%s\",\"depth\":%u,\"seldepth\":%u,\"eval\":%i,\"nodes\":%lu,\"qnodes\":%lu,\"nps\":%lu,", type, depth, selectiveDepth, evaluation, (unsigned long)nodes, (unsigned long)quiescentNodes, (unsigned long)NodesPerSecond());
+        dbg_printf("\"ttProbes\":%lu,\"ttHits\":%lu,\"ttCutoffs\":%lu,\"nullMoveAttempts\":%lu,\"nullMoveCutoffs\":%lu,", (unsigned long)transpositionProbes, (unsigned long)transpositionHits, (unsigned long)transpositionCutoffs, (unsigned long)nullMoveAttempts, (unsigned long)nullMoveCutoffs);
+        dbg_printf("\"evalCacheProbes\":%lu,\"evalCacheHits\":%lu,\"lazyEvals\":%lu,", (unsigned long)evaluationCacheProbes, (unsigned long)evaluationCacheHits, (unsigned long)lazyEvaluations);
+        dbg_printf("\"lmrResearches\":%lu,\"futilityPrunes\":%lu,\"deltaPrunes\":%lu,\"badCapturePrunes\":%lu,", (unsigned long)lateMoveReductionResearches, (unsigned long)futilityPrunes, (unsigned long)deltaPrunes, (unsigned long)badCapturePrunes);
+        dbg_printf("\"reverseFutilityPrunes\":%lu,\"razorPrunes\":%lu,\"lateMovePrunes\":%lu,\"historyPrunes\":%lu,\"probCutPrunes\":%lu,", (unsigned long)reverseFutilityPrunes, (unsigned long)razorPrunes, (unsigned long)lateMovePrunes, (unsigned long)historyPrunes, (unsigned long)probCutPrunes);
+        dbg_printf("\"singularExtensions\":%lu,\"multiCutPrunes\":%lu,\"iirs\":%lu,\"mateDistancePrunes\":%lu,\"aspirationResearches\":%lu,", (unsigned long)singularExtensions, (unsigned long)multiCutPrunes, (unsigned long)internalIterativeReductions, (unsigned long)mateDistancePrunes, (unsigned long)aspirationResearches);
+        if (MateInMoves()) dbg_printf("\"mate\":%i,", MateInMoves());
+        dbg_printf("\"failHigh\":%lu,\"failHighFirst\":%lu,\"time\":%lu}\n", (unsigned long)failHigh, (unsigned long)failHighFirst, (unsigned long)time);
+    }
+
+    // Reductions grow with the logarithm of both the depth left and how many moves have already been searched
+    void Bot::InitializeLateMoveReductionTable () {
+        for (uint8_t depth = 1; depth < 16; depth++) {
+            for (uint8_t moveNumber = 1; moveNumber < 32; moveNumber++) lateMoveReductionTable[depth][moveNumber] = uint8_t(1 + log(double(depth)) * log(double(moveNumber)) / 2);
+        }
+    }
+
+#ifndef __TICE__
+    uint32_t Bot::Bench (const uint8_t depth) {
+        static const char* const positions[] = {
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            "r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2NBPN2/PP3PPP/R2QK2R w KQ - 0 1",
+            "r1bq1rk1/ppp2ppp/2np1n2/2b1p3/2B1P3/2NP1N2/PPP2PPP/R1BQ1RK1 w - - 0 1",
+            "2r3k1/pp3ppp/4pn2/3p4/3P4/2PBPN2/P4PPP/5RK1 b - - 0 1",
+            "8/5pk1/6p1/3R4/5P2/6P1/r5K1/8 w - - 0 1",
+            "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 1",
+            "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 0 1"
+        };
+
+        const bool previousRandomVariation = randomVariation;
+        const uint8_t previousStandardDepth = maximumStandardDepth;
+        const uint8_t previousDepth = maximumDepth;
+        uint32_t nodes = 0;
+
+        randomVariation = false;
+        SetDepthLimits(depth, depth * 3);
+
+        for (const char* position : positions) {
+            board->ImportFen(position);
+            Think();
+            nodes += searchStatistics.nodes;
+        }
+
+        randomVariation = previousRandomVariation;
+        SetDepthLimits(previousStandardDepth, previousDepth);
+
+        return nodes;
+    }
+#endif
+
+    void Bot::SetRandomSeed (uint32_t seed) {
+        randomState = seed ? seed : 0x9E3779B9; // Xorshift gets stuck on a state of zero
+    }
+
+    // Xorshift32, which only needs shifts and xors
+    uint32_t Bot::Random () {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+
+        return randomState;
+    }
+
     void Bot::ClearPrincipalVariation () {
-        for (uint16_t index = 0; index < maximumDepth; index++) principalVariation[index] = Move();
+        for (uint8_t ply = 0; ply < maximumDepth; ply++) principalVariationLength[ply] = 0;
     }
 
-    void Bot::StoreMoveInPrincipalVariationTable (const Move& move, const hash& zobristHash) {
-        uint16_t index = zobristHash % maxPrincipalVariationEntries;
+    Move* Bot::GetPrincipalVariation (const uint8_t ply) {
+        return principalVariation + ply * maximumDepth - ply * (ply - 1) / 2; // Each row is one move shorter than the row before it
+    }
 
-        if (searchPly != 0 && index == indexOfStartPrincipalMove) return; // Tried to overwrite principal move with a move in a later depth
-        else if (searchPly == 0) indexOfStartPrincipalMove = index;
+    void Bot::UpdatePrincipalVariation (const Move& move) {
+        Move* line = GetPrincipalVariation(searchPly);
+        const Move* childLine = GetPrincipalVariation(searchPly + 1);
+        const uint8_t childLength = searchPly + 1 < maximumDepth ? principalVariationLength[searchPly + 1] : 0;
 
-        principalVariationTable[index] = MovePosition(move, zobristHash);
+        line[0] = move;
+        for (uint8_t index = 0; index < childLength; index++) line[index + 1] = childLine[index];
+
+        principalVariationLength[searchPly] = childLength + 1;
+    }
+
+    void Bot::StoreInTranspositionTable (const Move& move, const hash& zobristHash, const eval evaluation, const int8_t depth, const uint8_t bound) {
+        TranspositionEntry& entry = transpositionTable[zobristHash % TRANSPOSITION_TABLE_ENTRIES];
+
+        // Another position always takes the slot, so a deep entry can't hold it for the rest of the search. The same position from this search is only replaced by a search that is at least as deep, so a quiescent result can't wipe out a deep one.
+        if (entry.zobristHash == zobristHash && entry.generation == transpositionGeneration && entry.depth > depth) return;
+
+        // Mates are stored as the distance from this position rather than from the root, so they're still right when reached through another line
+        const eval storedEvaluation = evaluation >= MATE_EVALUATION_THRESHOLD ? evaluation + searchPly : evaluation <= -MATE_EVALUATION_THRESHOLD ? evaluation - searchPly : evaluation;
+
+        entry = TranspositionEntry(Move::IsNullMove(move) && entry.zobristHash == zobristHash ? entry.move : move, zobristHash, storedEvaluation, depth, bound, transpositionGeneration);
+    }
+
+    eval Bot::FromTranspositionEvaluation (const eval evaluation) {
+        return evaluation >= MATE_EVALUATION_THRESHOLD ? evaluation - searchPly : evaluation <= -MATE_EVALUATION_THRESHOLD ? evaluation + searchPly : evaluation;
     }
 
-    Move Bot::ProbePrincipalVariationTable (const hash& zobristHash) {
-        const uint16_t index = zobristHash % maxPrincipalVariationEntries;
+    TranspositionEntry* Bot::ProbeTranspositionTable (const hash& zobristHash) {
+        TranspositionEntry& entry = transpositionTable[zobristHash % TRANSPOSITION_TABLE_ENTRIES];
+
+        ++statistics.transpositionProbes;
 
-        if (principalVariationTable[index].zobristHash == zobristHash) {
-            return principalVariationTable[index].move;
+        if (entry.bound && entry.zobristHash == zobristHash) {
+            ++statistics.transpositionHits;
+
+            return &entry;
         }
 
-        return Move();
+        return nullptr;
     }
 
     Move Bot::ProbeOpeningsTable (const hash& zobristHash) {
         possibleOpeningMovesAvailable = 0;
 
         for (uint16_t index = 0; index < OPENING_POSITIONS; ++index) {
-            if (openingHashes[index] == zobristHash) {
+            if (hash(openingHashes[index]) == zobristHash) {
                 for (uint8_t i = 0; i < board->movesAvailable; i++) {
                     if (Move::GetStart(openingMoves[index]) == Move::GetStart(board->legalMoves[i]) && Move::GetTarget(openingMoves[index]) == Move::GetTarget(board->legalMoves[i])) {
                         if (Move::IsPromotion(openingMoves[index])) {
@@ -59,59 +236,13 @@ namespace Chess {
             }
         }
 
-        if (possibleOpeningMovesAvailable) return possibleOpeningMoves[uint8_t(rand() % possibleOpeningMovesAvailable)];
+        if (possibleOpeningMovesAvailable) return possibleOpeningMoves[uint8_t(Random() % possibleOpeningMovesAvailable)];
 
         return Move();
     }
 
-    bool Bot::DoesMoveExist (const Move& move) {
-        board->GenerateLegalMoves(board->legalMoves, board->movesAvailable, false);
-
-        if (Move::IsNullMove(move)) return false;
-
-        for (uint8_t index = 0; index < board->movesAvailable; ++index) {
-            if (Move::IsEqual(move, board->legalMoves[index])) return true;
-        }
-
-        return false;
-    }
-
-    uint8_t Bot::GetPrincipalVariation (const uint8_t depth) {
-        Move move = ProbePrincipalVariationTable(board->lastZobristHash);
-        uint8_t count = 0;
-
-        ClearPrincipalVariation();
-
-        while (count < depth) {
-            if (DoesMoveExist(move)) {
-                board->MakeMove(move, true);
-                principalVariation[count++] = move;
-            } else if (count == 0) {
-                // Move does not exist
-                if (board->movesAvailable) {
-                    // Make a random move
-                    move = board->legalMoves[uint8_t(rand()) % board->movesAvailable];
-                    board->MakeMove(move, true);
-                    //DEBUG dbg_printf("RAND MOVE ");
-                    //DEBUG Move::Display(move);
-                    //DEBUG dbg_printf(";\n");
-                    principalVariation[count++] = move;
-                }
-                break;
-            } else break;
-
-            move = ProbePrincipalVariationTable(board->lastZobristHash);
-        }
-        
-        uint8_t movesToUndo = count;
-
-        while (movesToUndo-- > 0) board->UnMakeMove(false, true);
-
-        return count;
-    }
-
     void Bot::CheckIfTimeIsUp () {
-        if (nodes & 0x1F) return; // Quick way to make sure it checks somewhat often, but not all the time
+        if (statistics.nodes & 0x1F) return; // Quick way to make sure it checks somewhat often, but not all the time
 
         board->UpdateTimeRemaining();
 
@@ -121,7 +252,7 @@ namespace Chess {
 
     Move Bot::Think () {
         // Don't search if there is only one legal move
-        board->GenerateLegalMoves(board->legalMoves, board->movesAvailable, false);
+        board->GenerateLegalMoves(board->legalMoves, board->movesAvailable);
         if (board->movesAvailable == 1) return board->legalMoves[0];
 
         if (board->ply <= 9) {
@@ -129,7 +260,7 @@ namespace Chess {
             if (!Move::IsNullMove(openingMove)) return openingMove;
         }
 
-        Clear();
+        AgeSearchHeuristics();
 
         currentlyInEndGame = IsEndGame();
         startTime = clock();
@@ -138,218 +269,472 @@ namespace Chess {
 
         startingPly = board->ply;
 
+        // Only a singular extension search excludes a move, and it clears it again, so every ply starts out searching all of its moves
+        for (uint8_t ply = 0; ply < maximumDepth; ply++) legalMoveMemory[ply].excludedMove = Move();
+
         MoveEvaluation best;
         eval alpha = LOWEST_EVALUATION, beta = HIGHEST_EVALUATION;
+        eval aspirationWindowDelta = aspirationWindowWidth;
+
+        statistics = SearchStatistics();
+        searchStatistics = SearchStatistics();
+        iterationsCompleted = 0;
+        clock_t iterationStartTime = startTime;
 
         for (startingDepth = 1; startingDepth <= maximumStandardDepth;) {
-            //DEBUG dbg_printf("STARTING SEARCH AT DEPTH %u\n", startingDepth);
+            best.evaluation = Search<rootNode>(startingDepth, alpha, beta);
 
-            nodes = 0;
-            failHigh = 0;
-            failHighFirst = 0;
+            if (searchIsInterrupted) break;
 
-            best.evaluation = Search(startingDepth, alpha, beta, true);
+            // A failed aspiration window is only widened on the side that failed, by twice as much each time, and researched at the same depth, so its work counts towards this iteration.
+            // The failed search left its bound and move in the table, so the research starts from them.
+            if ((best.evaluation <= alpha && alpha > LOWEST_EVALUATION) || (best.evaluation >= beta && beta < HIGHEST_EVALUATION)) {
+                ++statistics.aspirationResearches;
 
-            if (searchIsInterrupted) {
-                //DEBUG dbg_printf("SEARCH INTERRUPTED\n");
-                break;
-            }
+                if (best.evaluation <= alpha) alpha = best.evaluation - aspirationWindowDelta > LOWEST_EVALUATION ? best.evaluation - aspirationWindowDelta : LOWEST_EVALUATION;
+                else beta = best.evaluation + aspirationWindowDelta < HIGHEST_EVALUATION ? best.evaluation + aspirationWindowDelta : HIGHEST_EVALUATION;
+
+                if (aspirationWindowDelta < HIGHEST_EVALUATION) aspirationWindowDelta *= 2;
 
-            if (best.evaluation < alpha || best.evaluation > beta) {
-                alpha = LOWEST_EVALUATION;
-                beta = HIGHEST_EVALUATION;
-                //DEBUG dbg_printf("WINDOW FAILED\n");
                 continue;
             }
 
-            alpha = best.evaluation - aspirationWindowWidth;
-            beta = best.evaluation + aspirationWindowWidth;
+            // The next depth starts from a narrow window around this one's score
+            aspirationWindowDelta = aspirationWindowWidth;
+            alpha = best.evaluation - aspirationWindowDelta > LOWEST_EVALUATION ? best.evaluation - aspirationWindowDelta : LOWEST_EVALUATION;
+            beta = best.evaluation + aspirationWindowDelta < HIGHEST_EVALUATION ? best.evaluation + aspirationWindowDelta : HIGHEST_EVALUATION;
 
-            GetPrincipalVariation(startingDepth);
-            best.move = principalVariation[0];
+            if (principalVariationLength[0]) best.move = principalVariation[0];
 
-            // Printing an update on the best moves for the current depth
-            //DEBUG dbg_printf("t: %lu, Dep: %u, Eval: %i, Node: %lu, Ord: %.2f, EG: %u, PV:", (clock() - startTime) / (CLOCKS_PER_SEC / 1000), startingDepth, best.evaluation, nodes, failHighFirst / failHigh, IsEndGame());
-            //DEBUG for (uint8_t i = 0; i < startingDepth; i++) {
-            //DEBUG     dbg_printf(" ");
-            //DEBUG     Move::Display(principalVariation[i]);
-            //DEBUG }
-            //DEBUG dbg_printf(";\n");
+            statistics.depth = startingDepth;
+            statistics.evaluation = best.evaluation;
+            statistics.time = (clock() - iterationStartTime) / (CLOCKS_PER_SEC / 1000);
+            iterationStartTime = clock();
 
-            if (best.evaluation >= HIGHEST_EVALUATION - maximumDepth) break;
+            iterationStatistics[iterationsCompleted++] = statistics;
+            searchStatistics.Add(statistics);
+            searchStatistics.evaluation = best.evaluation;
+            statistics = SearchStatistics();
+
+            if (logSearchStatistics) iterationStatistics[iterationsCompleted - 1].Log("iteration");
+
+            // A mate found within the depth searched won't get any shorter, for either side
+            if (iterationStatistics[iterationsCompleted - 1].MateInMoves() && HIGHEST_EVALUATION - (best.evaluation < 0 ? -best.evaluation : best.evaluation) <= startingDepth) break;
 
             ++startingDepth;
         }
 
+        // Work from an unfinished iteration still counts towards the whole search
+        statistics.time = (clock() - iterationStartTime) / (CLOCKS_PER_SEC / 1000);
+        searchStatistics.Add(statistics);
+
+        if (logSearchStatistics) searchStatistics.Log("search");
+
+        // Moves from the search have no notation, so hand back the matching legal move instead
+        for (uint8_t index = 0; index < board->movesAvailable; index++) {
+            if (board->legalMoves[index].data == best.move.data) return board->legalMoves[index];
+        }
+
         return best.move;
     }
 
+    template <Bot::NodeType nodeType>
     eval Bot::Search (int8_t depth, eval alpha, eval beta, bool doNullMove) {
-        CheckIfTimeIsUp();
+        constexpr bool isRootNode = nodeType == rootNode;
+        constexpr bool isPrincipalVariationNode = nodeType != nonPrincipalVariationNode;
+        constexpr NodeType quiescentNodeType = isPrincipalVariationNode ? principalVariationNode : nonPrincipalVariationNode;
 
-        ++nodes;
+        principalVariationLength[searchPly] = 0;
 
-        board->UpdateInCheck();
+        CheckIfTimeIsUp();
+
+        ++statistics.nodes;
+        if (searchPly >= statistics.selectiveDepth) statistics.selectiveDepth = searchPly + 1;
 
+        // Moves are flagged with GivesCheck before they're made, so MakeMove has already set whether the side to move is in check
         if (board->inCheck) depth++;
-        else if (depth == 1 && !Move::IsCapture(board->lastMove)) { // Futility Pruning
-            if (Evaluate() + pieceValues[Piece::knight - 1] < alpha) return QuiescentSearch(alpha, beta);
+        else if (!isRootNode && depth == 1 && !Move::IsCapture(board->lastMove)) { // Futility Pruning
+            if (Evaluate(alpha - pieceValues[Piece::knight - 1], alpha - pieceValues[Piece::knight - 1]) + pieceValues[Piece::knight - 1] < alpha) {
+                ++statistics.futilityPrunes;
+
+                return QuiescentSearch<quiescentNodeType>(alpha, beta);
+            }
         }
 
-        if (depth == 0) return QuiescentSearch(alpha, beta);
+        if (depth == 0) return QuiescentSearch<quiescentNodeType>(alpha, beta);
 
         board->UpdateThreefoldRepetition();
         board->UpdateFiftyMoveCount();
 
         if (board->repetitions >= 2 || board->fiftyMoveRule) return 0;
 
-        Move* legalMoves = legalMoveMemory[searchPly].legalMoves;
-        eval* scores = legalMoveMemory[searchPly].scores;
-        uint8_t& movesAvailable = legalMoveMemory[searchPly].movesAvailable;
+        // Mate distance pruning: nothing from here does better than mating on the next ply, or worse than being mated on this one
+        if (!isRootNode) {
+            if (alpha < LOWEST_EVALUATION + searchPly) alpha = LOWEST_EVALUATION + searchPly;
+            if (beta > HIGHEST_EVALUATION - searchPly - 1) beta = HIGHEST_EVALUATION - searchPly - 1;
+
+            if (alpha >= beta) {
+                ++statistics.mateDistancePrunes;
+
+                return alpha;
+            }
+        }
+
+        LegalMoveMemory& memory = legalMoveMemory[searchPly];
+        const bool isExcludedMoveSearch = !Move::IsNullMove(memory.excludedMove); // Its result isn't the position's, so it can't come from or go into the table
+
+        // The entry is copied out, as the searches below can replace it with another position's
+        const TranspositionEntry* entry = ProbeTranspositionTable(board->lastZobristHash);
+        const bool entryFound = entry != nullptr;
+        Move principalMove = entryFound ? entry->move : Move();
+        const eval entryEvaluation = entryFound ? FromTranspositionEvaluation(entry->evaluation) : 0;
+        const int8_t entryDepth = entryFound ? entry->depth : 0;
+        const uint8_t entryBound = entryFound ? entry->bound : 0;
+
+        if (entryFound && !isRootNode && !isExcludedMoveSearch && entryDepth >= depth) {
+            if ((entryBound == TranspositionEntry::lowerBound || entryBound == TranspositionEntry::exact) && entryEvaluation >= beta) {
+                ++statistics.transpositionCutoffs;
+
+                return beta;
+            }
+
+            if ((entryBound == TranspositionEntry::upperBound || entryBound == TranspositionEntry::exact) && entryEvaluation <= alpha) {
+                ++statistics.transpositionCutoffs;
 
-        board->GenerateLegalMoves(legalMoves, movesAvailable, false);
+                return alpha;
+            }
+
+            // A null window always falls on one side of an exact score, so only principal variation nodes get here
+            if (isPrincipalVariationNode && entryBound == TranspositionEntry::exact) {
+                ++statistics.transpositionCutoffs;
+
+                if (!Move::IsNullMove(principalMove)) {
+                    if (searchPly + 1 < maximumDepth) principalVariationLength[searchPly + 1] = 0;
+                    UpdatePrincipalVariation(principalMove);
+                }
+
+                return entryEvaluation;
+            }
+        }
+
+        const bool inCheck = board->inCheck;
+
+        // Nothing is searched past the last ply, but a mate or stalemate there still has to be recognised
+        if (searchPly >= maximumDepth - 1) {
+            board->GenerateLegalMoves(memory.legalMoves, memory.movesAvailable);
+
+            return Evaluate(alpha, beta);
+        }
+
+        board->UpdateInsufficentMaterial();
+        if (board->CheckGameState()) return Evaluate(alpha, beta);
+
+        // Pruning is only done away from the root and the principal variation, out of check, and where the window isn't about mate
+        const bool canPrune = !isPrincipalVariationNode && !inCheck && !isExcludedMoveSearch && alpha > -MATE_EVALUATION_THRESHOLD && beta < MATE_EVALUATION_THRESHOLD;
+        const eval staticEvaluation = canPrune && (useReverseFutilityPruning || useRazoring) ? Evaluate() : 0;
 
-        if (searchPly >= maximumDepth - 1 || board->CheckGameState()) return Evaluate();
+        // Reverse futility pruning: this far above beta, the opponent isn't expected to bring the score back with this little depth left
+        if (useReverseFutilityPruning && canPrune && depth <= reverseFutilityPruningDepth && staticEvaluation - reverseFutilityPruningMargin * depth >= beta) {
+            ++statistics.reverseFutilityPrunes;
+
+            return beta;
+        }
+
+        // Razoring: this far below alpha, only captures are likely to help, so the quiescent search decides whether to search at all
+        if (useRazoring && canPrune && depth <= razoringDepth && staticEvaluation + razoringMargin * depth <= alpha) {
+            const eval evaluation = QuiescentSearch<nonPrincipalVariationNode>(alpha, beta);
+
+            if (searchIsInterrupted) return 0;
+
+            if (evaluation <= alpha) {
+                ++statistics.razorPrunes;
+
+                return alpha;
+            }
+        }
 
         eval currentEvaluation = LOWEST_EVALUATION;
 
-        if (doNullMove && !board->inCheck && searchPly && ((board->sideToMove == Piece::white && (board->whiteQueensCount || board->whiteRooksCount)) || (board->sideToMove == Piece::black && (board->blackQueensCount || board->blackRooksCount))) && depth >= minNullDepth) {
+        if (!isPrincipalVariationNode && doNullMove && !board->inCheck && searchPly + minNullDepth < maximumDepth && ((board->sideToMove == Piece::white && (board->whiteQueensCount || board->whiteRooksCount)) || (board->sideToMove == Piece::black && (board->blackQueensCount || board->blackRooksCount))) && depth >= minNullDepth) {
+            ++statistics.nullMoveAttempts;
+
+            for (uint8_t ply = 0; ply < minNullDepth; ply++) legalMoveMemory[searchPly + ply].playedMove = Move();
+
             board->MakeNullMove();
             searchPly += minNullDepth;
 
-            currentEvaluation = -Search(depth - minNullDepth, -beta, -beta + 1, false);
+            currentEvaluation = -Search<nonPrincipalVariationNode>(depth - minNullDepth, -beta, -beta + 1, false);
 
             board->UnMakeNullMove();
             searchPly -= minNullDepth;
 
             if (searchIsInterrupted) return 0;
 
-            if (currentEvaluation >= beta) return beta;
+            if (currentEvaluation >= beta) {
+                ++statistics.nullMoveCutoffs;
+
+                return beta;
+            }
+        }
+
+        Move move;
+        eval score;
+
+        // ProbCut: a capture that beats beta by a margin even at a much lower depth almost always beats beta at the full depth
+        if (useProbCut && canPrune && depth >= probCutDepth) {
+            const eval probCutBeta = beta + probCutMargin;
+
+            InitializeMovePicker(memory, principalMove, true);
+
+            while (PickNextMove(memory, move, score)) {
+                if (!board->IsLegal(move)) continue;
+
+                move.check = board->GivesCheck(move);
+                memory.playedMove = move;
+                board->MakeMove(move, true);
+                ++searchPly;
+
+                // The quiescent search is much cheaper, and weeds out most captures before the reduced search is tried
+                currentEvaluation = -QuiescentSearch<nonPrincipalVariationNode>(-probCutBeta, -probCutBeta + 1);
+                if (currentEvaluation >= probCutBeta && !searchIsInterrupted) currentEvaluation = -Search<nonPrincipalVariationNode>(depth - probCutDepthReduction, -probCutBeta, -probCutBeta + 1);
+
+                board->UnMakeMove(false, true);
+                --searchPly;
+
+                if (searchIsInterrupted) return 0;
+
+                if (currentEvaluation >= probCutBeta) {
+                    ++statistics.probCutPrunes;
+
+                    StoreInTranspositionTable(move, board->lastZobristHash, beta, depth - probCutDepthReduction + 1, TranspositionEntry::lowerBound);
+
+                    return beta;
+                }
+            }
+        }
+
+        // Singular extensions: when every other move falls well short of the hash move's score, the hash move is the only one that holds, so it gets an extra ply
+        bool principalMoveIsSingular = false;
+
+        if (useSingularExtensions && entryFound && !isRootNode && !isExcludedMoveSearch && depth >= singularExtensionDepth && !Move::IsNullMove(principalMove) && entryDepth >= depth - 3 && entryBound != TranspositionEntry::upperBound && entryEvaluation > -MATE_EVALUATION_THRESHOLD && entryEvaluation < MATE_EVALUATION_THRESHOLD) {
+            const eval singularBeta = entryEvaluation - singularExtensionMargin * depth;
+
+            memory.excludedMove = principalMove;
+            currentEvaluation = Search<nonPrincipalVariationNode>((depth - 1) / 2, singularBeta - 1, singularBeta, false);
+            memory.excludedMove = Move();
+
+            if (searchIsInterrupted) return 0;
+
+            if (currentEvaluation < singularBeta) {
+                principalMoveIsSingular = true;
+                ++statistics.singularExtensions;
+            } else if (singularBeta >= beta) { // Multi-cut: even without the hash move, another move beats beta
+                ++statistics.multiCutPrunes;
+
+                return beta;
+            }
+        }
+
+        // Internal iterative reductions: with no hash move the first moves are a guess, so the node is searched a ply shallower, which also leaves a hash move for the next iteration
+        if (useInternalIterativeReductions && Move::IsNullMove(principalMove) && !isExcludedMoveSearch && depth >= internalIterativeReductionDepth) {
+            ++statistics.internalIterativeReductions;
+            --depth;
         }
 
         Move bestMove;
         currentEvaluation = LOWEST_EVALUATION;
         eval startingAlpha = alpha;
-        Move principalMove = ProbePrincipalVariationTable(board->lastZobristHash);
 
-        ScoreMoves(legalMoves, scores, movesAvailable);
+        uint8_t movesSearched = 0;
 
-        if (!Move::IsNullMove(principalMove)) {
-            for (uint8_t index = 0; index < movesAvailable; index++) {
-                if (Move::IsEqual(legalMoves[index], principalMove)) scores[index] += 5000;
-            }
-        }
+        InitializeMovePicker(memory, principalMove, false);
+
+        while (PickNextMove(memory, move, score)) {
+            if (isExcludedMoveSearch && Move::IsEqual(move, memory.excludedMove)) continue;
+            if (!board->IsLegal(move)) continue;
 
-        for (uint8_t index = 0, lateMoveReductions; index < movesAvailable/*  && (currentlyInEndGame || depth < 3 || !index || scores[index]) */; index++) { // Late move pruning
-            SetNextMove(legalMoves, scores, movesAvailable, index);
+            if (memory.stage != LegalMoveMemory::quietMoves) move.check = board->GivesCheck(move); // Quiet moves found out when they were scored
 
-            board->MakeMove(legalMoves[index], true);
+            // With little depth left, quiet moves this far down the list or with this bad a history are skipped, once something has been searched
+            if (canPrune && movesSearched && !move.check && memory.stage == LegalMoveMemory::quietMoves) {
+                if (useLateMovePruning && depth <= lateMovePruningDepth && movesSearched >= lateMovePruningMoves + depth * depth) {
+                    ++statistics.lateMovePrunes;
+                    continue;
+                }
+
+                if (useHistoryPruning && depth <= historyPruningDepth && score < -historyPruningMargin * depth) {
+                    ++statistics.historyPrunes;
+                    continue;
+                }
+            }
+
+            memory.playedMove = move;
+            board->MakeMove(move, true);
             ++searchPly;
 
-            lateMoveReductions = depth >= 2 && index ? (scores[index] >= 900 ? 0 : scores[index] || depth == 2 || currentlyInEndGame ? 1 : 2) : 0;
-            currentEvaluation = -Search(depth - 1 - lateMoveReductions, -beta, -alpha, true);
+            // Late move reductions, which leave the hash move, good captures, killers, the counter move and checks alone
+            uint8_t lateMoveReductions = 0;
+
+            if (depth >= 2 && movesSearched && !move.check && memory.stage >= LegalMoveMemory::quietMoves) {
+                if (useLateMoveReductionTable) {
+                    lateMoveReductions = lateMoveReductionTable[depth < 16 ? depth : 15][movesSearched < 32 ? movesSearched : 31];
+
+                    // Losing captures, quiet moves with a good history, and moves on the principal variation are only reduced by one ply
+                    if (isPrincipalVariationNode || memory.stage != LegalMoveMemory::quietMoves || score > 0) lateMoveReductions = 1;
+
+                    if (lateMoveReductions > depth - 1) lateMoveReductions = depth - 1;
+                } else lateMoveReductions = memory.stage == LegalMoveMemory::quietMoves && score <= 0 && depth > 2 && !currentlyInEndGame ? 2 : 1;
+            }
+
+            const int8_t extension = principalMoveIsSingular && Move::IsEqual(move, principalMove) ? 1 : 0;
+
+            // Principal variation search: past the first move, a null window only has to show a move is no better than alpha, which is far cheaper than scoring it
+            if (isPrincipalVariationNode && !movesSearched) currentEvaluation = -Search<principalVariationNode>(depth - 1 + extension, -beta, -alpha);
+            else {
+                currentEvaluation = -Search<nonPrincipalVariationNode>(depth - 1 + extension - lateMoveReductions, -alpha - 1, -alpha);
+
+                // A reduced move that beats alpha has to prove itself at full depth
+                if (lateMoveReductions && currentEvaluation > alpha && !searchIsInterrupted) {
+                    ++statistics.lateMoveReductionResearches;
+
+                    currentEvaluation = -Search<nonPrincipalVariationNode>(depth - 1 + extension, -alpha - 1, -alpha);
+                }
+
+                // And one that beats it at full depth too gets its actual score
+                if (isPrincipalVariationNode && currentEvaluation > alpha && currentEvaluation < beta && !searchIsInterrupted) currentEvaluation = -Search<principalVariationNode>(depth - 1 + extension, -beta, -alpha);
+            }
 
             board->UnMakeMove(false, true);
             --searchPly;
+            ++movesSearched;
 
             if (searchIsInterrupted) return 0;
 
             if (currentEvaluation > alpha) {
                 if (currentEvaluation >= beta) {
-                    //DEBUG dbg_printf("PRUNED!\n");
-                    if (index == 0) ++failHighFirst;
-                    ++failHigh;
+                    if (movesSearched == 1) ++statistics.failHighFirst;
+                    ++statistics.failHigh;
+
+                    if (!Move::IsCapture(move)) { // Flags a good move that is not a capture
+                        const int16_t bonus = depth >= 10 ? maxHistoryBonus : depth * depth * 16;
+                        const Move previousMove = GetPreviousMove(1);
+
+                        killerMoves[searchPly][1] = killerMoves[searchPly][0];
+                        killerMoves[searchPly][0] = move;
+
+                        if (!Move::IsNullMove(previousMove)) counterMoves[Piece::GetLinearValue(previousMove.pieceMoved)][Move::GetTarget(previousMove)] = move.data;
+
+                        UpdateQuietHistories(memory, move, bonus);
 
-                    if (!Move::IsCapture(legalMoves[index])) { // Flags a good move that is not a capture
-                        killerMoves[1][searchPly] = killerMoves[0][searchPly];
-                        killerMoves[0][searchPly] = legalMoves[index];
+                        // Every quiet move searched before this one should have been searched after it
+                        for (uint8_t index = 0; index < memory.quietMovesTriedCount; index++) {
+                            Move triedMove(memory.quietMovesTried[index]);
+                            triedMove.pieceMoved = board->matrix[Move::GetStart(triedMove)];
+
+                            UpdateQuietHistories(memory, triedMove, -bonus);
+                        }
                     }
 
+                    if (!isExcludedMoveSearch) StoreInTranspositionTable(move, board->lastZobristHash, beta, depth, TranspositionEntry::lowerBound);
+
                     return beta;
                 }
 
                 alpha = currentEvaluation;
-                bestMove = legalMoves[index];
+                bestMove = move;
+                if (isPrincipalVariationNode) UpdatePrincipalVariation(bestMove);
 
-                if (!Move::IsCapture(legalMoves[index])) searchHistory[Piece::GetLinearValue(legalMoves[index].pieceMoved)][Move::GetTarget(legalMoves[index])] += depth;
+                if (!Move::IsCapture(move)) UpdateQuietHistories(memory, move, depth * 2);
             }
+
+            if (!Move::IsCapture(move) && memory.quietMovesTriedCount < LegalMoveMemory::maxQuietMovesTried) memory.quietMovesTried[memory.quietMovesTriedCount++] = move.data;
         }
 
-        if (alpha != startingAlpha) StoreMoveInPrincipalVariationTable(bestMove, board->lastZobristHash);
+        // Moves are only found to be illegal as they're tried, so mate and stalemate show up as nothing having been searched. Without the excluded move, it only means that move is the only one.
+        if (!movesSearched) return isExcludedMoveSearch ? alpha : inCheck ? LOWEST_EVALUATION + searchPly : 0;
+
+        if (!isExcludedMoveSearch) StoreInTranspositionTable(bestMove, board->lastZobristHash, alpha, depth, alpha != startingAlpha ? TranspositionEntry::exact : TranspositionEntry::upperBound);
 
         return alpha;
     }
 
+    template <Bot::NodeType nodeType>
     eval Bot::QuiescentSearch (eval alpha, eval beta) {
-        CheckIfTimeIsUp();
+        principalVariationLength[searchPly] = 0;
 
-        ++nodes;
+        CheckIfTimeIsUp();
 
-        board->UpdateInCheck();
+        if (board->inCheck) return Search<nodeType>(0, alpha, beta);
 
-        if (board->inCheck) return Search(0, alpha, beta, true);
+        ++statistics.nodes;
+        ++statistics.quiescentNodes;
+        if (searchPly >= statistics.selectiveDepth) statistics.selectiveDepth = searchPly + 1;
 
-        Move* legalMoves = legalMoveMemory[searchPly].legalMoves;
-        eval* scores = legalMoveMemory[searchPly].scores;
-        uint8_t& movesAvailable = legalMoveMemory[searchPly].movesAvailable;
+        LegalMoveMemory& memory = legalMoveMemory[searchPly];
 
         if (searchPly >= maximumDepth - 1) {
-            board->GenerateLegalMoves(legalMoves, movesAvailable, false);
+            board->GenerateLegalMoves(memory.legalMoves, memory.movesAvailable);
 
             return Evaluate();
         }
 
-        eval evaluation = Evaluate();
+        eval evaluation = Evaluate(alpha, beta);
+        const eval standingPat = evaluation;
 
         if (evaluation >= beta) return beta;
 
         if (evaluation > alpha) alpha = evaluation;
 
-        board->GenerateLegalMoves(legalMoves, movesAvailable, true);
-
-        if (!movesAvailable) return alpha;
-
         Move bestMove;
         evaluation = LOWEST_EVALUATION;
         eval startingAlpha = alpha;
-        Move principalMove = ProbePrincipalVariationTable(board->lastZobristHash);
+        TranspositionEntry* entry = ProbeTranspositionTable(board->lastZobristHash);
 
-        ScoreMoves(legalMoves, scores, movesAvailable);
+        Move move;
+        eval score;
+        uint8_t movesSearched = 0;
 
-        if (!Move::IsNullMove(principalMove)) {
-            for (uint8_t index = 0; index < movesAvailable; index++) {
-                if (Move::IsEqual(legalMoves[index], principalMove)) scores[index] += 5000;
-            }
-        }
+        // Captures that lose material are never handed out here, the picker counts them as pruned instead
+        InitializeMovePicker(memory, entry ? entry->move : Move(), true);
 
-        for (uint8_t index = 0; index < movesAvailable; index++) {
-            SetNextMove(legalMoves, scores, movesAvailable, index);
+        while (PickNextMove(memory, move, score)) {
+            if (!board->IsLegal(move)) continue;
+
+            move.check = board->GivesCheck(move);
+
+            // Even winning the captured piece for free wouldn't be enough to reach alpha, unless it also checks
+            if (!Move::IsPromotion(move) && !move.check && standingPat + pieceValues[(Move::IsFlag(move, Move::enPassant) ? piece(Piece::pawn) : Piece::GetPiece(move.pieceCaptured)) - 1] + deltaPruningMargin <= alpha) {
+                ++statistics.deltaPrunes;
+                continue;
+            }
 
-            board->MakeMove(legalMoves[index], true);
+            memory.playedMove = move;
+            board->MakeMove(move, true);
             ++searchPly;
 
-            evaluation = -QuiescentSearch(-beta, -alpha);
+            evaluation = -QuiescentSearch<nodeType>(-beta, -alpha);
 
             board->UnMakeMove(false, true);
             --searchPly;
+            ++movesSearched;
 
             if (searchIsInterrupted) return 0;
 
             if (evaluation > alpha) {
                 if (evaluation >= beta) {
-                    // dbg_printf("PRUNED!\n");
-                    if (index == 0) ++failHighFirst;
-                    ++failHigh;
+                    if (movesSearched == 1) ++statistics.failHighFirst;
+                    ++statistics.failHigh;
 
                     return beta;
                 }
 
                 alpha = evaluation;
-                bestMove = legalMoves[index];
+                bestMove = move;
+                if (nodeType == principalVariationNode) UpdatePrincipalVariation(bestMove);
             }
         }
 
-        if (alpha != startingAlpha) StoreMoveInPrincipalVariationTable(bestMove, board->lastZobristHash);
+        if (alpha != startingAlpha) StoreInTranspositionTable(bestMove, board->lastZobristHash, alpha, 0, TranspositionEntry::exact);
 
         return alpha;
     }
@@ -378,161 +763,721 @@ namespace Chess {
         scores[bestIndex] = temporaryScore;
     }
 
-    void Bot::ScoreMoves (Move* moves, eval* scores, uint8_t availableMoves) {
+    void Bot::InitializeMovePicker (LegalMoveMemory& memory, const Move& principalMove, const bool onlyCaptures) {
+        memory.stage = LegalMoveMemory::hashMove;
+        memory.onlyCaptures = onlyCaptures;
+        memory.principalMove = principalMove;
+        memory.movesAvailable = memory.capturesAvailable = 0;
+        memory.captureIndex = memory.quietIndex = memory.killerIndex = 0;
+        memory.quietMovesTriedCount = 0;
+        memory.counterMove = Move();
+
+        const Move previousMoves[2] = { GetPreviousMove(1), GetPreviousMove(2) };
+
+        if (!onlyCaptures && !Move::IsNullMove(previousMoves[0]) && counterMoves[Piece::GetLinearValue(previousMoves[0].pieceMoved)][Move::GetTarget(previousMoves[0])]) {
+            memory.counterMove = Move(counterMoves[Piece::GetLinearValue(previousMoves[0].pieceMoved)][Move::GetTarget(previousMoves[0])]);
+            memory.counterMove.pieceMoved = board->matrix[Move::GetStart(memory.counterMove)];
+            memory.counterMove.pieceCaptured = board->matrix[Move::GetTarget(memory.counterMove)];
+        }
+
+#ifndef __TICE__
+        for (uint8_t index = 0; index < 2; index++) memory.continuationHistories[index] = continuationHistory && !Move::IsNullMove(previousMoves[index]) ? continuationHistory + Piece::GetLinearValue(previousMoves[index].pieceMoved) * 64 + Move::GetTarget(previousMoves[index]) : nullptr;
+#endif
+    }
+
+    // Moves played before the search started come from the game, and a null move is returned for any ply that was a null move
+    Move Bot::GetPreviousMove (const uint8_t plies) {
+        if (searchPly >= plies) return legalMoveMemory[searchPly - plies].playedMove;
+
+        return board->ply >= plies - searchPly ? board->moveHistory[board->ply - (plies - searchPly)] : Move();
+    }
+
+    eval Bot::GetQuietHistory ([[maybe_unused]] const LegalMoveMemory& memory, const Move& move) {
+        const uint8_t linear = Piece::GetLinearValue(move.pieceMoved);
+        const uint8_t target = Move::GetTarget(move);
+        eval history = searchHistory[linear][target];
+
+#ifndef __TICE__
+        for (uint8_t index = 0; index < 2; index++) if (memory.continuationHistories[index]) history += (*memory.continuationHistories[index])[linear][target];
+#endif
+
+        return history;
+    }
+
+    void Bot::UpdateQuietHistories ([[maybe_unused]] const LegalMoveMemory& memory, const Move& move, const int16_t bonus) {
+        const uint8_t linear = Piece::GetLinearValue(move.pieceMoved);
+        const uint8_t target = Move::GetTarget(move);
+
+        UpdateHistory(searchHistory[linear][target], bonus);
+
+#ifndef __TICE__
+        for (uint8_t index = 0; index < 2; index++) {
+            if (memory.continuationHistories[index]) {
+                UpdateHistory((*memory.continuationHistories[index])[linear][target], bonus);
+                continuationHistoryIsEmpty = false;
+            }
+        }
+#endif
+    }
+
+    // Gravity: the closer an entry already is to the limit in the bonus's direction, the less it moves, so entries never overflow and old results fade out
+    void Bot::UpdateHistory (int16_t& entry, const int16_t bonus) {
+        entry += bonus - int16_t(int32_t(entry) * (bonus < 0 ? -bonus : bonus) / maxHistory);
+    }
+
+    /*
+    Hands out the moves of a position one at a time, best first, generating each group only once the ones before it are used up:
+    the hash move, captures that don't lose material, the killer moves, quiet moves, and finally captures that do lose material.
+    A cutoff from the hash move or a capture means the quiet moves are never generated at all.
+    */
+    bool Bot::PickNextMove (LegalMoveMemory& memory, Move& move, eval& score) {
+        switch (memory.stage) {
+            case LegalMoveMemory::hashMove:
+                memory.stage = LegalMoveMemory::generateCaptures;
+
+                if (!Move::IsNullMove(memory.principalMove) && (!memory.onlyCaptures || Move::IsCapture(memory.principalMove)) && board->IsPseudoLegal(memory.principalMove)) {
+                    move = memory.principalMove;
+                    score = hashMoveScore;
+
+                    return true;
+                }
+                [[fallthrough]];
+
+            case LegalMoveMemory::generateCaptures:
+                board->GeneratePseudoLegalMoves<Board::captures>(memory.legalMoves, memory.capturesAvailable);
+                ScoreMoves(memory.legalMoves, memory.scores, memory.capturesAvailable, memory);
+                memory.movesAvailable = memory.capturesAvailable;
+                memory.stage = LegalMoveMemory::goodCaptures;
+                [[fallthrough]];
+
+            case LegalMoveMemory::goodCaptures:
+                while (memory.captureIndex < memory.capturesAvailable) {
+                    SetNextMove(memory.legalMoves, memory.scores, memory.capturesAvailable, memory.captureIndex);
+
+                    if (memory.scores[memory.captureIndex] < 0) break; // Only captures that lose material are scored below zero
+
+                    move = memory.legalMoves[memory.captureIndex];
+                    score = memory.scores[memory.captureIndex++];
+
+                    if (!Move::IsEqual(move, memory.principalMove)) return true;
+                }
+
+                if (memory.onlyCaptures) {
+                    statistics.badCapturePrunes += memory.capturesAvailable - memory.captureIndex;
+                    memory.stage = LegalMoveMemory::done;
+
+                    return false;
+                }
+
+                memory.stage = LegalMoveMemory::killerMoves;
+                [[fallthrough]];
+
+            case LegalMoveMemory::killerMoves:
+                while (memory.killerIndex < 2) {
+                    move = killerMoves[searchPly][memory.killerIndex];
+                    score = killerMoveScores[memory.killerIndex++];
+
+                    if (Move::IsNullMove(move) || Move::IsEqual(move, memory.principalMove) || (memory.killerIndex == 2 && Move::IsEqual(move, killerMoves[searchPly][0]))) continue;
+                    if (board->IsPseudoLegal(move)) return true;
+                }
+
+                memory.stage = LegalMoveMemory::counterMoves;
+                [[fallthrough]];
+
+            case LegalMoveMemory::counterMoves:
+                memory.stage = LegalMoveMemory::generateQuietMoves;
+
+                if (!Move::IsNullMove(memory.counterMove) && !Move::IsCapture(memory.counterMove) && !Move::IsEqual(memory.counterMove, memory.principalMove) && !Move::IsEqual(memory.counterMove, killerMoves[searchPly][0]) && !Move::IsEqual(memory.counterMove, killerMoves[searchPly][1]) && board->IsPseudoLegal(memory.counterMove)) {
+                    move = memory.counterMove;
+                    score = counterMoveScore;
+
+                    return true;
+                }
+                [[fallthrough]];
+
+            case LegalMoveMemory::generateQuietMoves:
+                // Quiet moves go straight in after the captures, and are counted on their own until they're scored
+                board->GeneratePseudoLegalMoves<Board::quietMoves>(memory.legalMoves + memory.capturesAvailable, memory.movesAvailable);
+                ScoreMoves(memory.legalMoves + memory.capturesAvailable, memory.scores + memory.capturesAvailable, memory.movesAvailable, memory);
+                memory.movesAvailable += memory.capturesAvailable;
+                memory.quietIndex = memory.capturesAvailable;
+                memory.stage = LegalMoveMemory::quietMoves;
+                [[fallthrough]];
+
+            case LegalMoveMemory::quietMoves:
+                while (memory.quietIndex < memory.movesAvailable) {
+                    SetNextMove(memory.legalMoves, memory.scores, memory.movesAvailable, memory.quietIndex);
+
+                    move = memory.legalMoves[memory.quietIndex];
+                    score = memory.scores[memory.quietIndex++];
+
+                    if (!Move::IsEqual(move, memory.principalMove) && !Move::IsEqual(move, killerMoves[searchPly][0]) && !Move::IsEqual(move, killerMoves[searchPly][1]) && !Move::IsEqual(move, memory.counterMove)) return true;
+                }
+
+                memory.stage = LegalMoveMemory::badCaptures;
+                [[fallthrough]];
+
+            case LegalMoveMemory::badCaptures:
+                while (memory.captureIndex < memory.capturesAvailable) {
+                    SetNextMove(memory.legalMoves, memory.scores, memory.capturesAvailable, memory.captureIndex);
+
+                    move = memory.legalMoves[memory.captureIndex];
+                    score = memory.scores[memory.captureIndex++];
+
+                    if (!Move::IsEqual(move, memory.principalMove)) return true;
+                }
+
+                memory.stage = LegalMoveMemory::done;
+        }
+
+        return false;
+    }
+
+    void Bot::ScoreMoves (Move* moves, eval* scores, uint8_t availableMoves, const LegalMoveMemory& memory) {
+        board->UpdateAttackMaps();
+
         for (uint8_t index = 0; index < availableMoves; ++index) {
             if (Move::IsCapture(moves[index])) {
-                scores[index] = victimValues[Piece::GetPiece(moves[index].pieceCaptured) - 1] + 6 - victimValues[Piece::GetPiece(moves[index].pieceMoved) - 1] / 100 + 2500;
-            } else if (Move::IsEqual(killerMoves[0][searchPly], moves[index])) scores[index] = 1000;
-            else if (Move::IsEqual(killerMoves[1][searchPly], moves[index])) scores[index] = 900;
-            else scores[index] = searchHistory[Piece::GetLinearValue(moves[index].pieceMoved)][Move::GetTarget(moves[index])];
+                const uint8_t capturedPiece = Move::IsFlag(moves[index], Move::enPassant) ? piece(Piece::pawn) : Piece::GetPiece(moves[index].pieceCaptured); // En passant leaves the target square empty
+
+                scores[index] = victimValues[capturedPiece - 1] + 6 - victimValues[Piece::GetPiece(moves[index].pieceMoved) - 1] / 100;
+
+                // Taking a piece worth at least as much can't lose material, so only the rest need the exchange played out
+                if (pieceValues[capturedPiece - 1] >= pieceValues[Piece::GetPiece(moves[index].pieceMoved) - 1] || StaticExchangeEvaluation(moves[index]) >= 0) scores[index] += goodCaptureScore;
+                else scores[index] += badCaptureScore;
+            } else if (Move::IsEqual(killerMoves[searchPly][0], moves[index])) scores[index] = killerMoveScores[0];
+            else if (Move::IsEqual(killerMoves[searchPly][1], moves[index])) scores[index] = killerMoveScores[1];
+            else {
+                scores[index] = GetQuietHistory(memory, moves[index]);
+
+                // Saving an attacked piece that nothing defends goes first, and leaving one on such a square goes last. A piece attacks the squares it can move to, so it doesn't count as defending its own target, unless it's a pawn push.
+                const piece side = Piece::GetSide(moves[index].pieceMoved);
+                const piece opposingSide = Piece::GetOppositeSide(moves[index].pieceMoved);
+                const eval pieceValue = victimValues[Piece::GetPiece(moves[index].pieceMoved) - 1];
+                const uint8_t start = Move::GetStart(moves[index]);
+                const uint8_t target = Move::GetTarget(moves[index]);
+
+                // Kept with the move, so the search doesn't have to work it out again
+                moves[index].check = board->GivesCheck(moves[index]);
+                if (moves[index].check) scores[index] += quietCheckScore;
+
+                if (Piece::IsPiece(moves[index].pieceMoved, Piece::king)) continue; // Kings can't move into attacks, and can't be left in one either
+
+                if (board->IsSquareAttacked(start, opposingSide) && !board->IsSquareAttacked(start, side)) scores[index] += pieceValue;
+                if (board->IsSquareAttacked(target, opposingSide) && board->attackerCounts[side == Piece::white][target] <= (Piece::IsPiece(moves[index].pieceMoved, Piece::pawn) ? 0 : 1)) scores[index] -= pieceValue;
+            }
         }
     }
 
-    eval Bot::Evaluate () {
+    // Plays out every capture on the move's target square, each side always recapturing with its least valuable piece and stopping once that would lose material
+    eval Bot::StaticExchangeEvaluation (const Move& move) {
+        const uint8_t target = Move::GetTarget(move);
+        const bool isEnPassant = Move::IsFlag(move, Move::enPassant);
+        int32_t gains[32];
+        uint8_t depth = 0;
+        uint64_t removedSquares = uint64_t(1) << Move::GetStart(move); // Pieces that have left for the target square, so the ones lined up behind them come into play
+        piece side = Piece::GetOppositeSide(move.pieceMoved);
+        uint8_t pieceOnTarget = Move::IsPromotion(move) ? Piece::knight + (Move::GetFlag(move) & 0b11) : Piece::GetPiece(move.pieceMoved);
+
+        gains[0] = isEnPassant ? pieceValues[Piece::pawn - 1] : Move::IsCapture(move) ? pieceValues[Piece::GetPiece(move.pieceCaptured) - 1] : 0;
+        if (Move::IsPromotion(move)) gains[0] += pieceValues[pieceOnTarget - 1] - pieceValues[Piece::pawn - 1];
+        if (isEnPassant) removedSquares |= uint64_t(1) << (Move::GetStart(move) / 8 * 8 + target % 8);
+
+        for (uint8_t attacker; depth < 31 && (attacker = GetLeastValuableAttacker(target, side, removedSquares)) != OFFBOARD; side = Piece::GetOppositeSide(side)) {
+            depth++;
+            gains[depth] = pieceValues[pieceOnTarget - 1] - gains[depth - 1];
+
+            // Neither side would want this capture made, so it's left out
+            if ((-gains[depth - 1] > gains[depth] ? -gains[depth - 1] : gains[depth]) < 0) {
+                depth--;
+                break;
+            }
+
+            removedSquares |= uint64_t(1) << attacker;
+            pieceOnTarget = Piece::GetPiece(board->matrix[attacker]);
+        }
+
+        for (; depth > 0; depth--) gains[depth - 1] = -(-gains[depth - 1] > gains[depth] ? -gains[depth - 1] : gains[depth]);
+
+        return gains[0];
+    }
+
+    uint8_t Bot::GetLeastValuableAttacker (const uint8_t square, const piece side, const uint64_t removedSquares) {
+        const int8_t file = square % 8;
+        const int8_t rank = square / 8;
+
+        // Pawns attack from the rank behind the square, as seen from their side
+        const int8_t pawnRank = side == Piece::white ? rank + 1 : rank - 1;
+        if (pawnRank >= 0 && pawnRank < 8) {
+            for (int8_t pawnFile = file - 1; pawnFile <= file + 1; pawnFile += 2) {
+                const uint8_t pawnSquare = pawnRank * 8 + pawnFile;
+                if (pawnFile >= 0 && pawnFile < 8 && board->matrix[pawnSquare] == (side | Piece::pawn) && !(removedSquares & (uint64_t(1) << pawnSquare))) return pawnSquare;
+            }
+        }
+
+        for (uint8_t i = 0; i < attackTables.knightTargetCounts[square]; i++) {
+            const uint8_t knightSquare = attackTables.knightTargets[square][i];
+            if (board->matrix[knightSquare] == (side | Piece::knight) && !(removedSquares & (uint64_t(1) << knightSquare))) return knightSquare;
+        }
+
+        // The first piece along each ray, looking through the ones that have already captured
+        uint8_t attacker = OFFBOARD;
+        uint8_t attackerPiece = Piece::king;
+
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t raySquare = square;
+
+            for (uint8_t distance = attackTables.rayLengths[i][square]; distance; distance--) {
+                raySquare += attackTables.directionSteps[i];
+                if (board->matrix[raySquare] == Piece::empty || (removedSquares & (uint64_t(1) << raySquare))) continue;
+
+                const uint8_t rayPiece = Piece::GetPiece(board->matrix[raySquare]);
+                const bool canAttackAlongRay = rayPiece == Piece::queen || rayPiece == (i < 4 ? Piece::bishop : Piece::rook);
+
+                if (Piece::IsSide(board->matrix[raySquare], side) && canAttackAlongRay && rayPiece < attackerPiece) {
+                    attacker = raySquare;
+                    attackerPiece = rayPiece;
+                }
+                break;
+            }
+        }
+
+        if (attacker != OFFBOARD) return attacker;
+
+        for (uint8_t i = 0; i < attackTables.kingTargetCounts[square]; i++) {
+            const uint8_t kingSquare = attackTables.kingTargets[square][i];
+            if (board->matrix[kingSquare] == (side | Piece::king) && !(removedSquares & (uint64_t(1) << kingSquare))) return kingSquare;
+        }
+
+        return OFFBOARD;
+    }
+
+    eval Bot::Evaluate (const eval alpha, const eval beta) {
         if (board->blackWins || board->whiteWins) return LOWEST_EVALUATION + searchPly;
         else if (board->stalemate || board->insufficentMaterial || board->fiftyMoveRule || board->threefoldRepetition || board->repetitions >= 2 || board->ply >= MAX_MOVE_HISTORY - 2) return 0;
 
-        eval evaluation = 0;
+#ifndef __TICE__
+        if (network.isLoaded) return EvaluateNeuralNetwork() + (randomVariation ? eval((Random() % randomFactor) << 1) - randomFactor : 0);
+#endif
 
         bool isEndGame = IsEndGame();
 
-        for (uint8_t rank = 0, square = 0; rank < 8; ++rank) {
-            for (uint8_t file = 0; file < 8; ++file, ++square) {
-                if (board->matrix[square] == Piece::empty) continue;
+        // The hash is folded into the stored key with the evaluation, so a torn or overwritten entry can never be mistaken for a hit
+        EvaluationEntry& entry = evaluationCache[board->lastZobristHash % EVALUATION_CACHE_ENTRIES];
+        eval evaluation;
 
-                uint8_t index = Piece::GetPiece(board->matrix[square]) - 1;
-                if (index == Piece::king - 1 && isEndGame) ++index;
+        ++statistics.evaluationCacheProbes;
 
-                eval coefficient = Piece::IsSide(board->matrix[square], Piece::white) ? 1 : -1;
+        if ((entry.key ^ hash(uint16_t(entry.evaluation))) == board->lastZobristHash) {
+            ++statistics.evaluationCacheHits;
+            evaluation = entry.evaluation;
+        } else {
+            // Material and piece-square tables alone can be so far outside the window that nothing else could bring them back into it
+            MaterialEntry& materialEntry = ProbeMaterialTable();
+            if (materialEntry.endGame == MaterialEntry::none && materialEntry.scaleFactors[0] == normalScaleFactor && materialEntry.scaleFactors[1] == normalScaleFactor) {
+                evaluation = (int32_t(board->middleGameEvaluation) * materialEntry.gamePhase + int32_t(board->endGameEvaluation) * (maximumGamePhase - materialEntry.gamePhase)) / maximumGamePhase;
+                if (board->sideToMove == Piece::black) evaluation *= -1;
 
-                evaluation += coefficient * pieceValues[index];
-                evaluation += coefficient * pieceSquareTables[index][(coefficient == 1 ? rank : 7 - rank) * 4 + (file < 4 ? file : 7 - file)];
+                if (evaluation + lazyEvaluationMargin <= alpha || evaluation - lazyEvaluationMargin >= beta) {
+                    ++statistics.lazyEvaluations;
 
-                if (index == Piece::pawn - 1) {
-                    bool isPassedPawn = true;
-                    bool isIsolatedPawn = true;
-                    bool isDoubledPawn = false;
+                    return evaluation;
+                }
+            }
 
-                    if (coefficient == 1 && rank > 1) { // White Pawn
-                        for (uint8_t currentRank = rank - 1, currentSquare = file > 0 ? square - 9 : square - 8; currentRank > 0 && isPassedPawn; --currentRank, currentSquare -= file > 0 && file < 7 ? 11 : 10) {
-                            for (uint8_t currentFile = file > 0 ? file - 1 : 0; currentFile <= file + 1 && currentFile < 8 && isPassedPawn; ++currentFile, ++currentSquare) {
-                                if (board->matrix[currentSquare] == Piece::blackPawn) isPassedPawn = false;
-                            }
-                        }
-                    } else if (coefficient == -1 && rank < 6) { // Black Pawn
-                        for (uint8_t currentRank = rank + 1, currentSquare = file > 0 ? square + 7 : square + 8; currentRank < 7 && isPassedPawn; ++currentRank, currentSquare += file > 0 && file < 7 ? 5 : 6) {
-                            for (uint8_t currentFile = file > 0 ? file - 1 : 0; currentFile <= file + 1 && currentFile < 8 && isPassedPawn; ++currentFile, ++currentSquare) {
-                                if (board->matrix[currentSquare] == Piece::whitePawn) isPassedPawn = false;
-                            }
-                        }
-                    }
+            evaluation = EvaluatePosition(isEndGame);
+            entry.key = board->lastZobristHash ^ hash(uint16_t(evaluation));
+            entry.evaluation = evaluation;
+        }
 
-                    if (file > 0) {
-                        for (uint8_t currentSquare = (square - 1) % 8 + 8; currentSquare < 56 && isIsolatedPawn; currentSquare += 8) {
-                            if (board->matrix[square] == board->matrix[currentSquare]) isIsolatedPawn = false;
-                        }
-                    }
+        evaluation = EvaluateGameHistory(evaluation, isEndGame);
 
-                    if (isIsolatedPawn && file < 7) {
-                        for (uint8_t currentSquare = (square + 1) % 8 + 8; currentSquare < 56 && isIsolatedPawn; currentSquare += 8) {
-                            if (board->matrix[square] == board->matrix[currentSquare]) isIsolatedPawn = false;
-                        }
-                    }
+        if (randomVariation) evaluation += eval((Random() % randomFactor) << 1) - randomFactor;
 
-                    for (uint8_t currentSquare = square % 8 + 8; currentSquare < 56 && !isDoubledPawn; currentSquare += 8) {
-                        if (square != currentSquare && board->matrix[square] == board->matrix[currentSquare]) isDoubledPawn = true;
-                    }
+        return evaluation;
+    }
 
-                    if (isPassedPawn) {
-                        bool isProtectedPassedPawn = false;
-
-                        if (coefficient == 1) {
-                            for (uint8_t currentSquare = square % 8 + 56; currentSquare > square; currentSquare -= 8) {
-                                if (board->matrix[currentSquare] == Piece::whiteRook) isProtectedPassedPawn = true;
-                                else if (board->matrix[currentSquare] != Piece::empty && isProtectedPassedPawn) {
-                                    isProtectedPassedPawn = false;
-                                    break;
-                                }
-                            }
-                        } else {
-                            for (uint8_t currentSquare = square % 8; currentSquare < square; currentSquare += 8) {
-                                if (board->matrix[currentSquare] == Piece::blackRook) isProtectedPassedPawn = true;
-                                else if (board->matrix[currentSquare] != Piece::empty && isProtectedPassedPawn) {
-                                    isProtectedPassedPawn = false;
-                                    break;
-                                }
-                            }
-                        }
+    // Everything that depends on how the position was reached, which isn't part of the hash
+    eval Bot::EvaluateGameHistory (eval evaluation, const bool isEndGame) {
+        if (isEndGame) {
+            if (evaluation >= winingLimit && Move::IsCapture(board->lastMove) && (board->ply < 2 || Move::IsCapture(board->moveHistory[board->ply - 2]))) evaluation += tradingWhileWinningBonus;
+        } else {
+            eval castling = 0;
 
-                        evaluation += coefficient * (passedPawnBonus + (isEndGame ? passedPawnEndGameBonuses : passedPawnBonuses)[coefficient == 1 ? rank : 7 - rank]);
-                        if (isProtectedPassedPawn) evaluation += coefficient * protectedPassedPawnBonus;
-                    }
-                    if (isIsolatedPawn) evaluation += coefficient * isolatedPawnPenalty;
-                    if (isDoubledPawn) evaluation += coefficient * doubledPawnPenalty;
-                } else if (index == Piece::rook - 1 || index == Piece::queen - 1) {
-                    bool onOpenFile = true;
-                    bool onSemiOpenFile = true;
-                    piece pieceFoundOnFile;
-
-                    for (uint8_t currentSquare = square % 8 + 8; currentSquare < 56 && onSemiOpenFile; currentSquare += 8) {
-                        if (Piece::IsPiece(board->matrix[currentSquare], Piece::pawn)) {
-                            if (pieceFoundOnFile == Piece::empty) {
-                                pieceFoundOnFile = board->matrix[currentSquare];
-                                onOpenFile = false;
-                            } else if (pieceFoundOnFile != board->matrix[currentSquare]) { // Found Pawn of Opposite Color
-                                onSemiOpenFile = false;
-                            }
-                        }
-                    }
+            if (board->whiteCastled) castling += castlingBonus;
+            else {
+                if (board->whiteKingCastleRights) castling += castlingAsAnOptionBonus;
+                if (board->whiteQueenCastleRights) castling += castlingAsAnOptionBonus;
+            }
+            if (board->blackCastled) castling -= castlingBonus;
+            else {
+                if (board->blackKingCastleRights) castling -= castlingAsAnOptionBonus;
+                if (board->blackQueenCastleRights) castling -= castlingAsAnOptionBonus;
+            }
+            evaluation += board->sideToMove == Piece::white ? castling : -castling;
 
-                    if (index == Piece::rook - 1) {
-                        if (onOpenFile) evaluation += coefficient * rookOnOpenFileBonus;
-                        else if (onSemiOpenFile) evaluation += coefficient * rookOnSemiOpenFileBonus;
-                    } else {
-                        if (onOpenFile) evaluation += coefficient * queenOnOpenFileBonus;
-                        else if (onSemiOpenFile) evaluation += coefficient * queenOnSemiOpenFileBonus;
-                    }
+            if (Piece::IsPiece(board->lastMove.pieceMoved, Piece::king)) evaluation += opponentKingMoveBonus;
+            else if (Piece::IsPiece(board->lastMove.pieceMoved, Piece::pawn) && ((board->sideToMove == Piece::white && board->whiteCastled && !board->blackCastled) || (board->sideToMove == Piece::black && !board->whiteCastled && board->blackCastled))) evaluation += Move::IsCapture(board->lastMove) ? pawnBreakBonus : pawnMoveBonus;
+
+            if (!Move::IsNullMove(board->lastMove) && ((board->sideToMove == Piece::black && Move::GetStart(board->lastMove) / 8 > Move::GetTarget(board->lastMove) / 8) || (board->sideToMove == Piece::white && Move::GetStart(board->lastMove) / 8 < Move::GetTarget(board->lastMove) / 8))) evaluation -= forwardMoveBonus;
+        }
+
+        return evaluation;
+    }
+
+#ifndef __TICE__
+    bool Bot::LoadNeuralNetwork (const char* fileName) {
+        board->accumulator.isStale[0] = board->accumulator.isStale[1] = true;
+
+        return network.Load(fileName);
+    }
+
+    eval Bot::EvaluateNeuralNetwork () {
+        for (uint8_t perspective = 0; perspective < 2; perspective++) if (board->accumulator.isStale[perspective]) board->RefreshAccumulator(perspective);
+
+        uint8_t sideToMove = board->sideToMove == Piece::white;
+        int32_t evaluation = network.Propagate(board->accumulator.values[sideToMove], board->accumulator.values[!sideToMove]);
+
+        // Keeps a badly scaled network from ever producing what the search would read as a mate
+        if (evaluation > HIGHEST_EVALUATION / 2) return HIGHEST_EVALUATION / 2;
+        if (evaluation < LOWEST_EVALUATION / 2) return LOWEST_EVALUATION / 2;
+        return evaluation;
+    }
+
+    bool Bot::EvaluateBatch (const char* const* positions, const uint32_t numberOfPositions, eval* evaluations) {
+        EvaluationBatch* batch = (EvaluationBatch*)malloc(sizeof(EvaluationBatch));
+        if (batch == nullptr) return false;
+
+        // Batch positions are loaded over the board's own, which is put back once they've all been evaluated
+        LivePosition livePosition;
+        board->SaveLivePosition(livePosition);
+
+        for (uint32_t first = 0; first < numberOfPositions; first += EvaluationBatch::maxPositions) {
+            const uint16_t batchSize = numberOfPositions - first < EvaluationBatch::maxPositions ? numberOfPositions - first : EvaluationBatch::maxPositions;
+
+            for (uint16_t position = 0; position < batchSize; position++) batch->ImportFen(position, positions[first + position]);
+            batch->EvaluatePieceSquares(batchSize);
+
+            // The rest of the evaluation mostly comes from the pawn and material tables, so each position is set up just enough to probe them
+            for (uint16_t position = 0; position < batchSize; position++) {
+                board->LoadBatchPosition(*batch, position);
+
+                if (board->insufficentMaterial || board->ply >= MAX_MOVE_HISTORY - 2) evaluations[first + position] = 0;
+                else if (network.isLoaded) evaluations[first + position] = EvaluateNeuralNetwork();
+                else {
+                    const bool isEndGame = IsEndGame();
+                    evaluations[first + position] = EvaluateGameHistory(EvaluatePosition(isEndGame), isEndGame);
                 }
             }
         }
 
+        board->RestoreLivePosition(livePosition);
+        free(batch);
+
+        return true;
+    }
+#endif
+
+    // Walks the file from the side's back rank towards the opponent, so a rook is seen before the pawns it's behind
+    template <piece side>
+    eval Bot::EvaluateRooksBehindPassedPawns (const uint8_t file, const uint8_t rearmostPassedPawn) {
+        typedef Piece::SideTraits<side> Side;
+
+        eval evaluation = 0;
+        bool isProtectedPassedPawn = false;
+
+        for (uint8_t currentSquare = Side::backRank * 8 + file, rank = 0; rank < 7; currentSquare += Side::forward, ++rank) {
+            if (board->matrix[currentSquare] == Side::rook) isProtectedPassedPawn = true;
+            else if (board->matrix[currentSquare] == Side::pawn && (side == Piece::white ? currentSquare <= rearmostPassedPawn : currentSquare >= rearmostPassedPawn)) {
+                if (isProtectedPassedPawn) evaluation += protectedPassedPawnBonus;
+                isProtectedPassedPawn = false;
+            } else if (board->matrix[currentSquare] != Piece::empty) isProtectedPassedPawn = false;
+        }
+
+        return evaluation;
+    }
+
+    // The part of the evaluation that only depends on the position, from the perspective of the side to move
+    eval Bot::EvaluatePosition (const bool isEndGame) {
+        MaterialEntry& materialEntry = ProbeMaterialTable();
+
+        if (materialEntry.endGame != MaterialEntry::none) {
+            eval evaluation = EvaluateEndGame(materialEntry);
+
+            return materialEntry.strongSide == board->sideToMove ? evaluation : -evaluation;
+        }
+
+        // Material and piece-square tables, tapered between the middle game and end game by how much material is left
+        eval evaluation = (int32_t(board->middleGameEvaluation) * materialEntry.gamePhase + int32_t(board->endGameEvaluation) * (maximumGamePhase - materialEntry.gamePhase)) / maximumGamePhase;
+
+        PawnEntry& pawnEntry = ProbePawnTable();
+        evaluation += isEndGame ? pawnEntry.endGameEvaluation : pawnEntry.middleGameEvaluation;
+
+        // Rooks directly behind passed pawns
+        for (uint8_t file = 0; file < 8; ++file) {
+            if (pawnEntry.whitePassedPawnSquares[file] != OFFBOARD) evaluation += EvaluateRooksBehindPassedPawns<Piece::white>(file, pawnEntry.whitePassedPawnSquares[file]);
+            if (pawnEntry.blackPassedPawnSquares[file] != OFFBOARD) evaluation -= EvaluateRooksBehindPassedPawns<Piece::black>(file, pawnEntry.blackPassedPawnSquares[file]);
+        }
+
+        for (uint8_t square = 0; square < 64; ++square) {
+            if (!Piece::IsPiece(board->matrix[square], Piece::rook) && !Piece::IsPiece(board->matrix[square], Piece::queen)) continue;
+
+            eval coefficient = Piece::IsSide(board->matrix[square], Piece::white) ? 1 : -1;
+
+            const uint8_t fileMask = 1 << (square % 8);
+            bool onOpenFile = !((pawnEntry.blackPawnFiles | pawnEntry.whitePawnFiles) & fileMask);
+            bool onSemiOpenFile = !(pawnEntry.blackPawnFiles & pawnEntry.whitePawnFiles & fileMask); // Only pawns of one color are on the file
+
+            if (Piece::IsPiece(board->matrix[square], Piece::rook)) {
+                if (onOpenFile) evaluation += coefficient * rookOnOpenFileBonus;
+                else if (onSemiOpenFile) evaluation += coefficient * rookOnSemiOpenFileBonus;
+            } else {
+                if (onOpenFile) evaluation += coefficient * queenOnOpenFileBonus;
+                else if (onSemiOpenFile) evaluation += coefficient * queenOnSemiOpenFileBonus;
+            }
+        }
+
         if (board->whiteBishopsCount >= 2) evaluation += bishopPairBonus;
         if (board->blackBishopsCount >= 2) evaluation -= bishopPairBonus;
 
-        if (!isEndGame) {
-            if (board->whiteCastled) evaluation += castlingBonus;
-            else {
-                if (board->whiteKingCastleRights) evaluation += castlingAsAnOptionBonus;
-                if (board->whiteQueenCastleRights) evaluation += castlingAsAnOptionBonus;
-            }
-            if (board->blackCastled) evaluation -= castlingBonus;
-            else {
-                if (board->blackKingCastleRights) evaluation -= castlingAsAnOptionBonus;
-                if (board->blackQueenCastleRights) evaluation -= castlingAsAnOptionBonus;
-            }
-        } else {
+        board->UpdateAttackMaps();
+        evaluation += mobilityBonus * (board->attackedSquaresCount[1] - board->attackedSquaresCount[0]);
+        if (!isEndGame) evaluation += kingZoneAttackPenalty * (GetKingZoneAttacks(board->whiteKingSquare, Piece::black) - GetKingZoneAttacks(board->blackKingSquare, Piece::white));
+
+        if (isEndGame) {
             // Force king to corner
             if (board->sideToMove == Piece::white || (board->sideToMove == Piece::black && evaluation > 0)) evaluation += kingInCornerBonus * ((3 > board->blackKingFile ? 3 - board->blackKingFile : board->blackKingFile - 4) + (3 > board->blackKingRank ? 3 - board->blackKingFile : board->blackKingRank - 4)); // Wants black king in corner
             if (board->sideToMove == Piece::black || (board->sideToMove == Piece::white && evaluation < 0)) evaluation -= kingInCornerBonus * ((3 > board->whiteKingFile ? 3 - board->whiteKingFile : board->whiteKingFile - 4) + (3 > board->whiteKingRank ? 3 - board->whiteKingFile : board->whiteKingRank - 4)); // Wants white king in corner
         }
 
+        evaluation = int32_t(evaluation) * materialEntry.scaleFactors[evaluation > 0] / normalScaleFactor;
+
         if (board->sideToMove == Piece::black) evaluation *= -1;
 
         // Force kings together
-        if (isEndGame) {
-            if (evaluation >= winingLimit || evaluation <= losingLimit) evaluation -= (evaluation > 0 ? 1 : -1) * (board->blackQueensCount || board->whiteQueensCount || board->blackRooksCount || board->whiteRooksCount ? kingsTogetherMajorPiecesBonus : board->blackKnightsCount || board->whiteKnightsCount || board->blackBishopsCount || board->whiteBishopsCount ? kingsTogetherMinorPiecesBonus : kingsTogetherPawnsBonus) * (board->whiteKingFile > board->blackKingFile ? board->whiteKingFile - board->blackKingFile : board->blackKingFile - board->whiteKingFile) + (board->whiteKingRank > board->blackKingRank ? board->whiteKingRank - board->blackKingRank : board->blackKingRank - board->whiteKingRank);
+        if (isEndGame && (evaluation >= winingLimit || evaluation <= losingLimit)) evaluation -= (evaluation > 0 ? 1 : -1) * materialEntry.kingsTogetherBonus * (board->whiteKingFile > board->blackKingFile ? board->whiteKingFile - board->blackKingFile : board->blackKingFile - board->whiteKingFile) + (board->whiteKingRank > board->blackKingRank ? board->whiteKingRank - board->blackKingRank : board->blackKingRank - board->whiteKingRank);
 
-            if (evaluation >= winingLimit && Move::IsCapture(board->lastMove) && (board->ply < 2 || Move::IsCapture(board->moveHistory[board->ply - 2]))) evaluation += tradingWhileWinningBonus;
-        } else {
-            if (Piece::IsPiece(board->lastMove.pieceMoved, Piece::king)) evaluation += opponentKingMoveBonus;
-            else if (Piece::IsPiece(board->lastMove.pieceMoved, Piece::pawn) && ((board->sideToMove == Piece::white && board->whiteCastled && !board->blackCastled) || (board->sideToMove == Piece::black && !board->whiteCastled && board->blackCastled))) evaluation += Move::IsCapture(board->lastMove) ? pawnBreakBonus : pawnMoveBonus;
+        return evaluation;
+    }
 
-            if (!Move::IsNullMove(board->lastMove) && ((board->sideToMove == Piece::black && Move::GetStart(board->lastMove) / 8 > Move::GetTarget(board->lastMove) / 8) || (board->sideToMove == Piece::white && Move::GetStart(board->lastMove) / 8 < Move::GetTarget(board->lastMove) / 8))) evaluation -= forwardMoveBonus;
+    MaterialEntry& Bot::ProbeMaterialTable () {
+        MaterialEntry& entry = materialTable[board->materialZobristHash % MATERIAL_TABLE_ENTRIES];
+
+        if (!entry.isUsed || entry.materialZobristHash != board->materialZobristHash) EvaluateMaterial(entry);
+
+        return entry;
+    }
+
+    void Bot::EvaluateMaterial (MaterialEntry& entry) {
+        entry.materialZobristHash = board->materialZobristHash;
+        entry.isUsed = true;
+        entry.insufficentMaterial = board->IsInsufficentMaterial();
+        entry.endGame = MaterialEntry::none;
+        entry.strongSide = Piece::empty;
+
+        const uint8_t gamePhase = board->gamePhase;
+        entry.gamePhase = gamePhase < maximumGamePhase ? gamePhase : maximumGamePhase;
+
+        entry.kingsTogetherBonus = board->blackQueensCount || board->whiteQueensCount || board->blackRooksCount || board->whiteRooksCount ? kingsTogetherMajorPiecesBonus : board->blackKnightsCount || board->whiteKnightsCount || board->blackBishopsCount || board->whiteBishopsCount ? kingsTogetherMinorPiecesBonus : kingsTogetherPawnsBonus;
+
+        const eval blackPieceMaterial = board->blackKnightsCount * pieceValues[Piece::knight - 1] + board->blackBishopsCount * pieceValues[Piece::bishop - 1] + board->blackRooksCount * pieceValues[Piece::rook - 1] + board->blackQueensCount * pieceValues[Piece::queen - 1];
+        const eval whitePieceMaterial = board->whiteKnightsCount * pieceValues[Piece::knight - 1] + board->whiteBishopsCount * pieceValues[Piece::bishop - 1] + board->whiteRooksCount * pieceValues[Piece::rook - 1] + board->whiteQueensCount * pieceValues[Piece::queen - 1];
+
+        // Without pawns, being up by no more than a minor piece is rarely enough to win
+        for (uint8_t side = 0; side < 2; side++) {
+            const bool hasPawns = side ? board->whitePawnsCount : board->blackPawnsCount;
+            const eval pieceMaterial = side ? whitePieceMaterial : blackPieceMaterial;
+            const eval opponentPieceMaterial = side ? blackPieceMaterial : whitePieceMaterial;
+
+            if (entry.insufficentMaterial) entry.scaleFactors[side] = 0;
+            else if (!hasPawns && pieceMaterial - opponentPieceMaterial <= pieceValues[Piece::bishop - 1]) entry.scaleFactors[side] = pieceMaterial < pieceValues[Piece::rook - 1] ? 0 : 4;
+            else entry.scaleFactors[side] = normalScaleFactor;
         }
 
-        evaluation += ((rand() % randomFactor) << 1) - randomFactor;
+        // Endings that are won or drawn by technique rather than search
+        for (uint8_t side = 0; side < 2; side++) {
+            const piece strongSide = side ? Piece::white : Piece::black;
+            const bool opponentHasBareKing = side ? !board->blackPawnsCount && !blackPieceMaterial : !board->whitePawnsCount && !whitePieceMaterial;
 
-        return evaluation;
+            if (!opponentHasBareKing) continue;
+
+            const uint8_t pawns = side ? board->whitePawnsCount : board->blackPawnsCount;
+            const uint8_t knights = side ? board->whiteKnightsCount : board->blackKnightsCount;
+            const uint8_t bishops = side ? board->whiteBishopsCount : board->blackBishopsCount;
+            const uint8_t rooks = side ? board->whiteRooksCount : board->blackRooksCount;
+            const uint8_t queens = side ? board->whiteQueensCount : board->blackQueensCount;
+
+            if (queens || rooks) entry.endGame = MaterialEntry::majorPieceVersusKing;
+            else if (!pawns && knights == 1 && bishops == 1) entry.endGame = MaterialEntry::bishopAndKnightVersusKing;
+            else if (pawns == 1 && !knights && !bishops) entry.endGame = MaterialEntry::pawnVersusKing;
+            else continue;
+
+            entry.strongSide = strongSide;
+            break;
+        }
+    }
+
+    // Evaluates a recognized ending from the perspective of the strong side
+    eval Bot::EvaluateEndGame (const MaterialEntry& entry) {
+        const bool whiteIsStrong = entry.strongSide == Piece::white;
+        const uint8_t strongKingSquare = whiteIsStrong ? board->whiteKingSquare : board->blackKingSquare;
+        const uint8_t weakKingSquare = whiteIsStrong ? board->blackKingSquare : board->whiteKingSquare;
+        const eval material = whiteIsStrong ? board->middleGameEvaluation : -board->middleGameEvaluation;
+
+        switch (entry.endGame) {
+            case MaterialEntry::majorPieceVersusKing:
+                // Drive the king to the edge and bring the other king in to help mate
+                return knownWinBonus + material + cornerDistanceBonus * GetCenterDistance(weakKingSquare) + kingDistanceBonus * (7 - GetDistance(strongKingSquare, weakKingSquare));
+            case MaterialEntry::bishopAndKnightVersusKing: {
+                // Mate is only possible in a corner the bishop can reach
+                uint8_t bishopSquare = 0;
+                while (board->matrix[bishopSquare] != (whiteIsStrong ? Piece::whiteBishop : Piece::blackBishop)) ++bishopSquare;
+
+                const bool bishopIsOnLightSquare = !((bishopSquare / 8 + bishopSquare % 8) & 1);
+                const uint8_t cornerDistance = bishopIsOnLightSquare ? (GetDistance(weakKingSquare, A8) < GetDistance(weakKingSquare, H1) ? GetDistance(weakKingSquare, A8) : GetDistance(weakKingSquare, H1)) : (GetDistance(weakKingSquare, H8) < GetDistance(weakKingSquare, A1) ? GetDistance(weakKingSquare, H8) : GetDistance(weakKingSquare, A1));
+
+                return knownWinBonus + material + cornerDistanceBonus * (7 - cornerDistance) + kingDistanceBonus * (7 - GetDistance(strongKingSquare, weakKingSquare));
+            }
+            case MaterialEntry::pawnVersusKing: {
+                uint8_t pawnSquare = 0;
+                while (board->matrix[pawnSquare] != (whiteIsStrong ? Piece::whitePawn : Piece::blackPawn)) ++pawnSquare;
+
+                const uint8_t file = pawnSquare % 8;
+                const uint8_t relativeRank = whiteIsStrong ? 7 - pawnSquare / 8 : pawnSquare / 8; // 1 on the pawn's starting rank, 6 just before promoting
+                const uint8_t promotionSquare = whiteIsStrong ? file : file + 56;
+                const bool weakSideToMove = board->sideToMove != entry.strongSide;
+                const eval drawishEvaluation = pieceValues[Piece::pawn - 1] / 4 + relativeRank * 5;
+                const eval winningEvaluation = knownWinBonus + pieceValues[Piece::pawn - 1] + relativeRank * cornerDistanceBonus;
+
+                // The pawn is lost if the weak king can take it before it's defended
+                if (weakSideToMove && GetDistance(weakKingSquare, pawnSquare) == 1 && GetDistance(strongKingSquare, pawnSquare) > 1) return 0;
+
+                // Rule of the square, as long as the strong king isn't in the pawn's way
+                const uint8_t pawnMovesToPromote = 7 - (relativeRank == 1 ? 2 : relativeRank);
+                if (GetDistance(weakKingSquare, promotionSquare) - (weakSideToMove ? 1 : 0) > pawnMovesToPromote && !(strongKingSquare % 8 == file && (whiteIsStrong ? strongKingSquare < pawnSquare : strongKingSquare > pawnSquare))) return winningEvaluation;
+
+                // A rook pawn can't win once the weak king gets to the corner in front of it
+                if ((file == 0 || file == 7) && GetDistance(weakKingSquare, promotionSquare) <= 1) return 0;
+
+                // The strong king on a key square in front of the pawn wins no matter who moves
+                const int8_t direction = whiteIsStrong ? -8 : 8;
+                for (uint8_t ranksAhead = relativeRank >= 4 ? 1 : 2; ranksAhead <= 2 && relativeRank + ranksAhead <= 7; ranksAhead++) {
+                    const uint8_t keySquare = pawnSquare + direction * ranksAhead;
+
+                    if (strongKingSquare / 8 == keySquare / 8 && (strongKingSquare % 8 > file ? strongKingSquare % 8 - file : file - strongKingSquare % 8) <= 1 && !(file == 0 || file == 7)) return winningEvaluation;
+                }
+
+                return drawishEvaluation;
+            }
+        }
+
+        return 0;
+    }
+
+    // How many king moves a square is from the center four squares
+    uint8_t Bot::GetCenterDistance (const uint8_t square) {
+        const uint8_t file = square % 8, rank = square / 8;
+
+        return (file < 4 ? 3 - file : file - 4) + (rank < 4 ? 3 - rank : rank - 4);
+    }
+
+    // How many king moves it takes to get from one square to another
+    uint8_t Bot::GetDistance (const uint8_t square, const uint8_t otherSquare) {
+        const uint8_t fileDistance = square % 8 > otherSquare % 8 ? square % 8 - otherSquare % 8 : otherSquare % 8 - square % 8;
+        const uint8_t rankDistance = square / 8 > otherSquare / 8 ? square / 8 - otherSquare / 8 : otherSquare / 8 - square / 8;
+
+        return fileDistance > rankDistance ? fileDistance : rankDistance;
+    }
+
+    // How many times the attacking side attacks the king's square and the squares around it
+    uint8_t Bot::GetKingZoneAttacks (const uint8_t kingSquare, const piece attackingSide) {
+        uint8_t attacks = 0;
+
+        for (int8_t rank = kingSquare / 8 - 1; rank <= kingSquare / 8 + 1; rank++) {
+            for (int8_t file = kingSquare % 8 - 1; file <= kingSquare % 8 + 1; file++) {
+                if (file >= 0 && file < 8 && rank >= 0 && rank < 8) attacks += board->attackerCounts[attackingSide == Piece::white][rank * 8 + file];
+            }
+        }
+
+        return attacks;
+    }
+
+    PawnEntry& Bot::ProbePawnTable () {
+        PawnEntry& entry = pawnTable[board->pawnZobristHash % PAWN_TABLE_ENTRIES];
+
+        if (!entry.isUsed || entry.pawnZobristHash != board->pawnZobristHash) EvaluatePawnStructure(entry);
+
+        return entry;
+    }
+
+    void Bot::EvaluatePawnStructure (PawnEntry& entry) {
+        entry.pawnZobristHash = board->pawnZobristHash;
+        entry.isUsed = true;
+        entry.middleGameEvaluation = entry.endGameEvaluation = 0;
+        entry.blackPawnFiles = entry.whitePawnFiles = 0;
+        for (uint8_t file = 0; file < 8; ++file) entry.blackPassedPawnSquares[file] = entry.whitePassedPawnSquares[file] = OFFBOARD;
+
+        for (uint8_t rank = 0, square = 0; rank < 8; ++rank) {
+            for (uint8_t file = 0; file < 8; ++file, ++square) {
+                if (!Piece::IsPiece(board->matrix[square], Piece::pawn)) continue;
+
+                eval coefficient = Piece::IsSide(board->matrix[square], Piece::white) ? 1 : -1;
+
+                if (coefficient == 1) entry.whitePawnFiles |= 1 << file;
+                else entry.blackPawnFiles |= 1 << file;
+
+                bool isPassedPawn = true;
+                bool isIsolatedPawn = true;
+                bool isDoubledPawn = false;
+
+                if (coefficient == 1 && rank > 1) { // White Pawn
+                    for (uint8_t currentRank = rank - 1, currentSquare = file > 0 ? square - 9 : square - 8; currentRank > 0 && isPassedPawn; --currentRank, currentSquare -= file > 0 && file < 7 ? 11 : 10) {
+                        for (uint8_t currentFile = file > 0 ? file - 1 : 0; currentFile <= file + 1 && currentFile < 8 && isPassedPawn; ++currentFile, ++currentSquare) {
+                            if (board->matrix[currentSquare] == Piece::blackPawn) isPassedPawn = false;
+                        }
+                    }
+                } else if (coefficient == -1 && rank < 6) { // Black Pawn
+                    for (uint8_t currentRank = rank + 1, currentSquare = file > 0 ? square + 7 : square + 8; currentRank < 7 && isPassedPawn; ++currentRank, currentSquare += file > 0 && file < 7 ? 5 : 6) {
+                        for (uint8_t currentFile = file > 0 ? file - 1 : 0; currentFile <= file + 1 && currentFile < 8 && isPassedPawn; ++currentFile, ++currentSquare) {
+                            if (board->matrix[currentSquare] == Piece::whitePawn) isPassedPawn = false;
+                        }
+                    }
+                }
+
+                if (file > 0) {
+                    for (uint8_t currentSquare = (square - 1) % 8 + 8; currentSquare < 56 && isIsolatedPawn; currentSquare += 8) {
+                        if (board->matrix[square] == board->matrix[currentSquare]) isIsolatedPawn = false;
+                    }
+                }
+
+                if (isIsolatedPawn && file < 7) {
+                    for (uint8_t currentSquare = (square + 1) % 8 + 8; currentSquare < 56 && isIsolatedPawn; currentSquare += 8) {
+                        if (board->matrix[square] == board->matrix[currentSquare]) isIsolatedPawn = false;
+                    }
+                }
+
+                for (uint8_t currentSquare = square % 8 + 8; currentSquare < 56 && !isDoubledPawn; currentSquare += 8) {
+                    if (square != currentSquare && board->matrix[square] == board->matrix[currentSquare]) isDoubledPawn = true;
+                }
+
+                if (isPassedPawn) {
+                    entry.middleGameEvaluation += coefficient * (passedPawnBonus + passedPawnBonuses[coefficient == 1 ? rank : 7 - rank]);
+                    entry.endGameEvaluation += coefficient * (passedPawnBonus + passedPawnEndGameBonuses[coefficient == 1 ? rank : 7 - rank]);
+
+                    // Squares are visited from black's side of the board, so the last white passed pawn found on a file is the rearmost, as is the first black one
+                    if (coefficient == 1) entry.whitePassedPawnSquares[file] = square;
+                    else if (entry.blackPassedPawnSquares[file] == OFFBOARD) entry.blackPassedPawnSquares[file] = square;
+                }
+                if (isIsolatedPawn) {
+                    entry.middleGameEvaluation += coefficient * isolatedPawnPenalty;
+                    entry.endGameEvaluation += coefficient * isolatedPawnPenalty;
+                }
+                if (isDoubledPawn) {
+                    entry.middleGameEvaluation += coefficient * doubledPawnPenalty;
+                    entry.endGameEvaluation += coefficient * doubledPawnPenalty;
+                }
+            }
+        }
     }
 
     eval Bot::MaterialAdvantage () {
@@ -540,38 +1485,59 @@ namespace Chess {
     }
 
     bool Bot::IsEndGame () {
-        return ((((board->blackQueensCount || board->whiteQueensCount) && !board->blackRooksCount && !board->whiteRooksCount)
-            || ((board->blackRooksCount <= 1 || board->whiteRooksCount <= 1) && !board->blackQueensCount && !board->whiteQueensCount))
-            && (board->blackKnightsCount + board->blackBishopsCount <= 1 && board->whiteKnightsCount + board->whiteBishopsCount <= 1))
-            || (board->blackQueensCount + board->whiteQueensCount <= 1 && board->blackRooksCount + board->whiteRooksCount <= 1)
-            || ((board->blackRooksCount <= 2 || board->whiteRooksCount <= 2) && !board->blackQueensCount && !board->whiteQueensCount && !board->blackKnightsCount && !board->whiteKnightsCount && !board->blackBishopsCount && !board->whiteBishopsCount);
+        return board->gamePhase <= endGamePhase;
     }
 
-    // Used to generate opening moves in a condensed form
-    /* void Bot::PrintOpenings () {
-        for (uint16_t i = 0; i < OPENING_POSITIONS; i++) {
-            board->ImportFen(openings[i].fen);
-            dbg_printf("[\"0x%lX\", ", board->GenerateZobristHash());
-            dbg_printf("\"0x%lX\"], ", openings[i].move);
+    void Bot::AgeSearchHeuristics () {
+        ++transpositionGeneration;
+
+        for (uint8_t i = 0; i < 12; i++) {
+            for (uint8_t j = 0; j < 64; j++) {
+                searchHistory[i][j] /= 2;
+            }
+        }
+
+#ifndef __TICE__
+        if (continuationHistory && !continuationHistoryIsEmpty) for (uint32_t i = 0; i < uint32_t(12 * 64) * 12 * 64; i++) ((int16_t*)continuationHistory)[i] /= 2; // The tables are contiguous, so they're walked as one
+#endif
+
+        // Killer moves are stored by distance from the root, so they're moved back by however many plies the game has advanced since the last search. When it hasn't advanced, like a second search of the same position, they stay where they are.
+        const uint8_t pliesPlayed = board->ply > startingPly ? board->ply - startingPly : 0;
+
+        for (uint8_t i = 0; i < maximumDepth; i++) {
+            for (uint8_t j = 0; j < 2; j++) {
+                killerMoves[i][j] = i + pliesPlayed < maximumDepth ? killerMoves[i + pliesPlayed][j] : Move();
+            }
         }
-        dbg_printf(";\n");
-    } */
+
+        ClearPrincipalVariation();
+    }
 
     void Bot::Clear () {
-        for (uint16_t i = 0; i < maxPrincipalVariationEntries; i++) {
-            principalVariationTable[i] = MovePosition();
+        ClearPrincipalVariation();
+
+        for (uint32_t i = 0; i < TRANSPOSITION_TABLE_ENTRIES; i++) {
+            transpositionTable[i] = TranspositionEntry();
         }
 
         for (uint8_t i = 0; i < 12; i++) {
             for (uint8_t j = 0; j < 64; j++) {
                 searchHistory[i][j] = 0;
+                counterMoves[i][j] = 0;
             }
         }
 
-        for (uint8_t i = 0; i < 2; i++) {
-            for (uint8_t j = 0; j < maximumDepth; j++) {
+#ifndef __TICE__
+        if (continuationHistory && !continuationHistoryIsEmpty) for (uint32_t i = 0; i < uint32_t(12 * 64) * 12 * 64; i++) ((int16_t*)continuationHistory)[i] = 0;
+        continuationHistoryIsEmpty = true;
+#endif
+
+        for (uint8_t i = 0; i < maximumDepth; i++) {
+            for (uint8_t j = 0; j < 2; j++) {
                 killerMoves[i][j] = Move();
             }
         }
+
+        startingPly = board->ply;
     }
 }
\ No newline at end of file
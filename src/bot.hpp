@@ -24,38 +24,169 @@ namespace Chess {
         }
     };
 
+    typedef int16_t PieceToHistory[12][64]; // Indexed by the linear value of the piece moved and the square it moves to
+
+    /**
+     * The moves for one ply of the search, handed out in stages by Bot::PickNextMove so that moves after a cutoff are never generated.
+     * Moves are only pseudo-legal, so each is checked with Board::IsLegal before it's made. Captures fill the start of the list and quiet moves are added after them.
+     */
     struct LegalMoveMemory {
-        Move legalMoves[MAX_LEGAL_MOVES];
-        eval scores[MAX_LEGAL_MOVES];
+        Move legalMoves[MAX_PSEUDO_LEGAL_MOVES];
+        eval scores[MAX_PSEUDO_LEGAL_MOVES];
         uint8_t movesAvailable = 0;
 
+        enum : uint8_t {
+            hashMove,
+            generateCaptures,
+            goodCaptures,
+            killerMoves,
+            counterMoves,
+            generateQuietMoves,
+            quietMoves,
+            badCaptures,
+            done
+        };
+
+        uint8_t stage = done;
+        bool onlyCaptures = false;
+        Move principalMove;
+        uint8_t capturesAvailable = 0;
+        uint8_t captureIndex = 0;
+        uint8_t quietIndex = 0;
+        uint8_t killerIndex = 0;
+        Move counterMove;
+
+        Move excludedMove; // Left out while checking whether the hash move is singular, which is searched from the same ply
+        Move playedMove; // The move being searched from this ply, or a null move, which the plies below it look back on
+
+        // Quiet moves that were searched without a cutoff, which lose history if a later quiet move causes one. Only the move data is kept, as the position gives back the pieces.
+        static const uint8_t maxQuietMovesTried = 32;
+        uint16_t quietMovesTried[maxQuietMovesTried];
+        uint8_t quietMovesTriedCount = 0;
+
+#ifndef __TICE__
+        PieceToHistory* continuationHistories[2] = { nullptr, nullptr }; // Following the moves one and two plies back
+#endif
+
         LegalMoveMemory () {}
     };
 
-    struct MovePosition {
+    struct TranspositionEntry {
         Move move;
         hash zobristHash = 0;
+        eval evaluation = 0;
+        int8_t depth = 0;
+        uint8_t bound = 0;
+        uint8_t generation = 0;
+
+        static const uint8_t exact = 1;
+        static const uint8_t lowerBound = 2; // The position is worth at least the evaluation
+        static const uint8_t upperBound = 3; // The position is worth at most the evaluation
 
-        MovePosition () {}
+        TranspositionEntry () {}
 
-        MovePosition (Move _move, hash _zobristHash) {
+        TranspositionEntry (Move _move, hash _zobristHash, eval _evaluation, int8_t _depth, uint8_t _bound, uint8_t _generation) {
             move = _move;
             zobristHash = _zobristHash;
+            evaluation = _evaluation;
+            depth = _depth;
+            bound = _bound;
+            generation = _generation;
         }
     };
 
+    struct PawnEntry {
+        hash pawnZobristHash = 0;
+        bool isUsed = false;
+        eval middleGameEvaluation = 0; // Passed, isolated and doubled pawns from white's point of view. Rooks behind passed pawns aren't included, as they depend on more than the pawns.
+        eval endGameEvaluation = 0;
+        uint8_t blackPawnFiles = 0; // One bit per file with at least one pawn on it
+        uint8_t whitePawnFiles = 0;
+        uint8_t blackPassedPawnSquares[8]; // The rearmost passed pawn on each file, or OFFBOARD. Every pawn in front of it on that file is also passed.
+        uint8_t whitePassedPawnSquares[8];
+
+        PawnEntry () {}
+    };
+
+    struct MaterialEntry {
+        hash materialZobristHash = 0;
+        bool isUsed = false;
+        bool insufficentMaterial = false;
+        uint8_t gamePhase = 0; // Capped at the maximum game phase, unlike the board's counter
+        uint8_t scaleFactors[2] = { 16, 16 }; // Out of 16, applied when black (index 0) or white (index 1) is ahead, to pull drawish endings towards zero
+        eval kingsTogetherBonus = 0;
+        uint8_t endGame = none;
+        piece strongSide = Piece::empty;
+
+        enum : const uint8_t {
+            none,
+            majorPieceVersusKing, // A queen or rook, and anything else, against a bare king
+            bishopAndKnightVersusKing,
+            pawnVersusKing
+        };
+
+        MaterialEntry () {}
+    };
+
+    struct EvaluationEntry {
+        hash key = 0; // The position's hash xored with the evaluation
+        eval evaluation = 0;
+
+        EvaluationEntry () {}
+    };
+
+    struct SearchStatistics {
+        uint8_t depth = 0;
+        uint8_t selectiveDepth = 0; // Deepest ply reached, including quiescent search and extensions
+        eval evaluation = 0;
+        uint32_t nodes = 0; // Includes quiescent nodes
+        uint32_t quiescentNodes = 0;
+        uint32_t transpositionProbes = 0;
+        uint32_t transpositionHits = 0;
+        uint32_t transpositionCutoffs = 0;
+        uint32_t nullMoveAttempts = 0;
+        uint32_t nullMoveCutoffs = 0;
+        uint32_t lateMoveReductionResearches = 0;
+        uint32_t futilityPrunes = 0;
+        uint32_t deltaPrunes = 0; // Quiescent captures skipped because even winning the piece couldn't reach alpha
+        uint32_t badCapturePrunes = 0; // Quiescent captures skipped because they lose material
+        uint32_t reverseFutilityPrunes = 0;
+        uint32_t razorPrunes = 0;
+        uint32_t lateMovePrunes = 0;
+        uint32_t historyPrunes = 0;
+        uint32_t probCutPrunes = 0;
+        uint32_t singularExtensions = 0;
+        uint32_t multiCutPrunes = 0; // Singular extension searches that beat beta without the hash move
+        uint32_t internalIterativeReductions = 0;
+        uint32_t mateDistancePrunes = 0;
+        uint32_t aspirationResearches = 0; // Root searches repeated with a wider window after failing high or low
+        uint32_t evaluationCacheProbes = 0;
+        uint32_t evaluationCacheHits = 0;
+        uint32_t lazyEvaluations = 0; // Evaluations cut short because material alone was far outside the window
+        uint32_t failHigh = 0;
+        uint32_t failHighFirst = 0; // How often the first move searched caused the cutoff, which shows how good the move ordering is
+        uint32_t time = 0; // In milliseconds
+
+        SearchStatistics () {}
+
+        void Add (const SearchStatistics& other);
+        uint32_t NodesPerSecond () const;
+        int8_t MateInMoves () const; // Positive when the side to move mates, negative when it gets mated, and 0 without a forced mate
+        void Log (const char* type) const;
+    };
+
     struct Board;
 
     struct Bot {
         Board* board;
 
-        const hash openingHashes[OPENING_POSITIONS] = { 0x10DA59A4, 0x10DA59A4, 0x10DA59A4, 0x12DBFE12, 0x12DBFE12, 0x13A1770C, 0x13FF676A, 0x142882, 0x14417187, 0x1546C9FD, 0x1546C9FD, 0x1546C9FD, 0x1623583A, 0x18ACD073, 0x18ACD073, 0x18ACD073, 0x19AB6809, 0x1A3E0098, 0x1EC84E5D, 0x2076A2BC, 0x20A65BC6, 0x20A8B455, 0x2427F253, 0x2427F253, 0x24414FA9, 0x251A8527, 0x266991E8, 0x29CDEBDD, 0x2B71193E, 0x2D7CABF1, 0x2D7CABF1, 0x2D7CABF1, 0x2EA10C77, 0x2F0AAF09, 0x329C1B3A, 0x33A0CD2E, 0x33A0CD2E, 0x359BDFBE, 0x35DD84D8, 0x36950E0B, 0x37118D02, 0x3B7F1785, 0x3D822159, 0x3DBAB63F, 0x4074CF3B, 0x41E4324A, 0x41F8B9BD, 0x4249A790, 0x4249A790, 0x4316FC96, 0x474B8C79, 0x4DF78205, 0x4FA79D43, 0x509C16B, 0x51C615FE, 0x5312824B, 0x5312824B, 0x561496B5, 0x57B3EA8A, 0x57B3EA8A, 0x586854F0, 0x5A9514E, 0x5BFE8F3B, 0x5D4A458C, 0x5EF2A59A, 0x609F0176, 0x615F110, 0x615F110, 0x624D31B, 0x62D77808, 0x64DCA2DC, 0x6766AFED, 0x6B303CE4, 0x6C129E3D, 0x6CCC1F28, 0x6CCC1F28, 0x6DF1685C, 0x6E14CD84, 0x6E969686, 0x6EB4337E, 0x71318E9, 0x7245D7B6, 0x734BB379, 0x74C0E939, 0x74C0E939, 0x77236AD7, 0x792AF0B7, 0x79C0DB4B, 0x79C0DB4B, 0x7A73D65, 0x7E63D6E0, 0x8061A528, 0x82F639B0, 0x83C4D2D4, 0x857B0690, 0x8B58E4DE, 0x8B58E4DE, 0x8D715504, 0x8F54E531, 0x95385D3C, 0x957E9ADD, 0x957E9ADD, 0x9670B38B, 0x9FBB93D8, 0xA1DA5F87, 0xA2D14256, 0xA852C80D, 0xAF3B5BD8, 0xB0F75F99, 0xB3CB0E84, 0xB4AA3726, 0xBA199217, 0xBA9D1E9D, 0xBA9D1E9D, 0xBA9D1E9D, 0xC17A4F5B, 0xC232A1EC, 0xC232A1EC, 0xC3695115, 0xC46FA587, 0xC6079164, 0xC6AC21B8, 0xC723E3A5, 0xC8F0723F, 0xC9144AA5, 0xC98170F8, 0xCAA8FE16, 0xCAA8FE16, 0xCAC9FA2B, 0xCE9DCE9E, 0xCFC2F738, 0xD3A480D2, 0xD5286109, 0xD69A2891, 0xD905CB90, 0xD9AF655B, 0xDB4BEB57, 0xDB769316, 0xDC52180E, 0xDF5F5444, 0xE4267B06, 0xE7FDA349, 0xE8CF979C, 0xED69FA11, 0xF6DB9799, 0xF6DB9799, 0xF8CA3A12, 0xF8CA3A12, 0xFA0CAD1E };
+        const uint64_t openingHashes[OPENING_POSITIONS] = { 0x65C929D4E0E36E1F, 0x65C929D4E0E36E1F, 0x65C929D4E0E36E1F, 0x4165E36B694F3183, 0x4165E36B694F3183, 0x16BF7B90A0831C1A, 0xB4D074E328FD5DD3, 0x57E27DBD99C989C7, 0xC5F0B2811C1F9E63, 0x96CCFC886C8323B6, 0x96CCFC886C8323B6, 0x96CCFC886C8323B6, 0x8449FCC098CD1B33, 0xF7E2466A375ECE62, 0xF7E2466A375ECE62, 0xF7E2466A375ECE62, 0xA4DE086347C273B7, 0xAB074444101FDFD9, 0xB4E7277D49BC8122, 0x35E9EC380D8E2444, 0x7F8E8F49E44399BC, 0xB403F97437BA7CFD, 0x12F2010054E1E64D, 0x12F2010054E1E64D, 0x6BC3E92BF17FE616, 0xD1502996DD3D07DA, 0x1652CDB47E12FAF0, 0x73DCBBE20F3C0B99, 0x56167F9870F883AA, 0xB1309D7C5D3B1D91, 0xB1309D7C5D3B1D91, 0xB1309D7C5D3B1D91, 0x98F323FC228ECA7C, 0xDD3C4E1BF26254D5, 0xF80F42BA4B891DCD, 0x5235C7BC8D4E1574, 0x5235C7BC8D4E1574, 0xB02F75B60D8B06DA, 0x9FED11104AA1A634, 0xF00281A703BFC079, 0x90D9E122DF49037C, 0x912C3B4558622DAD, 0x5F5A16E44AD8F9DC, 0x92BAAB4D778E67BF, 0x470F3E8993EE1A50, 0xC3D982EDF95D2225, 0x026732CDEA03AF21, 0x4DFB6B47FFE9DE1D, 0x4DFB6B47FFE9DE1D, 0x29920C4C59EB6ED2, 0x8DE950E6D19C9EE0, 0x365B46FBD9AE9284, 0xF2B60B2278309689, 0x0E29DDC92CBE65C0, 0xDAE86A2D9BA4466F, 0x2E9A35E5DFB10384, 0x2E9A35E5DFB10384, 0x3639872D2DE8E93A, 0x5DAA7D77392E135A, 0x5DAA7D77392E135A, 0x8261665D7EEC9AF2, 0xFF723997CE4A5B39, 0x57173DCF763504EE, 0xC6F92A792D6B2695, 0x4D255C0731B9D7B8, 0xD089A63A1D5C06D2, 0x267019CBAEDDB75C, 0x267019CBAEDDB75C, 0xBDDEEB3809299F70, 0x0E628F141C9A4B08, 0x2352CAC6F91C959C, 0xD2FC5F59022A4879, 0xFE42580254F3C000, 0xEAFAE0DAFEE8E311, 0xA3DAED525B73E203, 0xA3DAED525B73E203, 0x6078C5C4D2AF0394, 0xAD69B15AF120F1E6, 0xA346887205E389EF, 0xD11E7F4AD645D6D2, 0x8494C620DC5E93E3, 0x73C65D12EF82DB25, 0xFA4C772FA7440B2A, 0x03CBB40B3248B720, 0x03CBB40B3248B720, 0xC13B1CDE902EF900, 0x62E50EE969955AF4, 0xD0AB44BF46C9AD13, 0xD0AB44BF46C9AD13, 0xF964A40AC480027A, 0x4695629FA24E6BD2, 0x040C4CA6235A4F93, 0xF3851327C1F66A0E, 0xEDD4653820599C19, 0x0B9D4C57CE47351C, 0x7AA364B7E9BFBFD6, 0x7AA364B7E9BFBFD6, 0x1BC44BBF0CF5A13C, 0x77373558072F5419, 0xAB93575206E9CF11, 0x6EB18B12702A8EB7, 0x6EB18B12702A8EB7, 0x6B0A88AF4B9897B2, 0x359FA86E376422AE, 0x7E0C421ECB04881E, 0x5040CE15466E4DDD, 0x4CDC4090DA124F1E, 0x316E74F71DB3A009, 0xA0DA154C176A66EE, 0x11328FBF61105596, 0x523278022376CBD9, 0x12D0AFACB57FCB3D, 0x5A5BDE462A94F75A, 0x5A5BDE462A94F75A, 0x5A5BDE462A94F75A, 0xFA8516AB1DA37A8E, 0x3A1CC95650D2222D, 0x3A1CC95650D2222D, 0xB9A26CA706FA65E0, 0x124D02B453CFBF42, 0x292F36D496FBDCB7, 0x56E98FFEE1D42870, 0x0C35C4376CE012B5, 0xD097CC8AF2382A46, 0xE3AE4C17B6854FD6, 0x02F4EE627E23992C, 0xEE989BE7892B1434, 0xEE989BE7892B1434, 0x6D1B7ED5373DFF61, 0xFDAB64654F02EAAE, 0x4306930C65364AF7, 0xF85690DBC73A5F4E, 0x6B61E76237071C2C, 0x588D80C8CCA23144, 0xA2146DD064BE7348, 0x71F785F35344ADC9, 0xA275F0D12A1CE3BF, 0x97546AE40CFE61EE, 0xEB2CFAB3BF8452EA, 0x79D656880626D458, 0xE40F371EDF25707B, 0x31558B4841518BD2, 0xA33B47A077C34C72, 0xBFB8E7E96329ED3C, 0x48DD1D3AAF2D7184, 0x48DD1D3AAF2D7184, 0x4C6FE3D05CB76B2F, 0x4C6FE3D05CB76B2F, 0x5B3DF31A41B4D793 }; // Full Zobrist hashes, which the calculator compares the low half of
         const Move openingMoves[OPENING_POSITIONS] = { Move(uint16_t(0xE73)), Move(uint16_t(0x96E)), Move(uint16_t(0xB5C)), Move(uint16_t(0xA6)), Move(uint16_t(0x210)), Move(uint16_t(0xCEB)), Move(uint16_t(0x9AD)), Move(uint16_t(0x2DB)), Move(uint16_t(0xA6)), Move(uint16_t(0xE73)), Move(uint16_t(0xCAA)), Move(uint16_t(0xCAA)), Move(uint16_t(0x314)), Move(uint16_t(0xFAD)), Move(uint16_t(0xE6A)), Move(uint16_t(0x8DA)), Move(uint16_t(0x52)), Move(uint16_t(0x52)), Move(uint16_t(0x2DB)), Move(uint16_t(0x49A)), Move(uint16_t(0x83B)), Move(uint16_t(0xD2C)), Move(uint16_t(0xFAD)), Move(uint16_t(0xE6A)), Move(uint16_t(0x195)), Move(uint16_t(0x195)), Move(uint16_t(0x91C)), Move(uint16_t(0xCAA)), Move(uint16_t(0xEE0)), Move(uint16_t(0x6D8)), Move(uint16_t(0x6C3)), Move(uint16_t(0x6D3)), Move(uint16_t(0xAA3)), Move(uint16_t(0x314)), Move(uint16_t(0x70B)), Move(uint16_t(0xA6)), Move(uint16_t(0x52)), Move(uint16_t(0xF59)), Move(uint16_t(0x29A)), Move(uint16_t(0x355)), Move(uint16_t(0xF62)), Move(uint16_t(0x52)), Move(uint16_t(0xAA3)), Move(uint16_t(0xF3B)), Move(uint16_t(0xFAD)), Move(uint16_t(0x6E4)), Move(uint16_t(0xCAA)), Move(uint16_t(0x49A)), Move(uint16_t(0x9D)), Move(uint16_t(0x102)), Move(uint16_t(0x314)), Move(uint16_t(0x2DB)), Move(uint16_t(0xB5C)), Move(uint16_t(0x95C)), Move(uint16_t(0xB5C)), Move(uint16_t(0xD2C)), Move(uint16_t(0xFAD)), Move(uint16_t(0x52)), Move(uint16_t(0xC6A)), Move(uint16_t(0xCEA)), Move(uint16_t(0xEED)), Move(uint16_t(0x853)), Move(uint16_t(0xA6)), Move(uint16_t(0xCAA)), Move(uint16_t(0x91B)), Move(uint16_t(0x195)), Move(uint16_t(0x292)), Move(uint16_t(0x2DB)), Move(uint16_t(0x52)), Move(uint16_t(0xA6)), Move(uint16_t(0xF59)), Move(uint16_t(0xCEB)), Move(uint16_t(0x621)), Move(uint16_t(0xFAD)), Move(uint16_t(0x314)), Move(uint16_t(0x396)), Move(uint16_t(0xD65)), Move(uint16_t(0xCA2)), Move(uint16_t(0xD1)), Move(uint16_t(0xCE3)), Move(uint16_t(0xA6)), Move(uint16_t(0xE6A)), Move(uint16_t(0xA6)), Move(uint16_t(0x52)), Move(uint16_t(0x314)), Move(uint16_t(0x8DB)), Move(uint16_t(0xA6)), Move(uint16_t(0x9D)), Move(uint16_t(0x195)), Move(uint16_t(0x355)), Move(uint16_t(0x6A3)), Move(uint16_t(0x91B)), Move(uint16_t(0xDB)), Move(uint16_t(0x6E4)), Move(uint16_t(0xCEB)), Move(uint16_t(0xEA5)), Move(uint16_t(0xFAD)), Move(uint16_t(0x52)), Move(uint16_t(0xD65)), Move(uint16_t(0x195)), Move(uint16_t(0x52)), Move(uint16_t(0x396)), Move(uint16_t(0xA6)), Move(uint16_t(0x756)), Move(uint16_t(0x934)), Move(uint16_t(0xFAD)), Move(uint16_t(0x2DB)), Move(uint16_t(0xF59)), Move(uint16_t(0x210)), Move(uint16_t(0xEE6)), Move(uint16_t(0xA9B)), Move(uint16_t(0xCE3)), Move(uint16_t(0x52)), Move(uint16_t(0x9D)), Move(uint16_t(0x195)), Move(uint16_t(0x195)), Move(uint16_t(0xA6)), Move(uint16_t(0x9D)), Move(uint16_t(0x52)), Move(uint16_t(0x292)), Move(uint16_t(0x195)), Move(uint16_t(0x315)), Move(uint16_t(0xFAD)), Move(uint16_t(0xCEB)), Move(uint16_t(0x49B)), Move(uint16_t(0xC61)), Move(uint16_t(0xCE3)), Move(uint16_t(0xD24)), Move(uint16_t(0xCAA)), Move(uint16_t(0xFAD)), Move(uint16_t(0xE6A)), Move(uint16_t(0x102)), Move(uint16_t(0x153)), Move(uint16_t(0xA6)), Move(uint16_t(0xCE3)), Move(uint16_t(0xF6B)), Move(uint16_t(0x314)), Move(uint16_t(0xEE9)), Move(uint16_t(0xEA5)), Move(uint16_t(0xEE9)), Move(uint16_t(0xB23)), Move(uint16_t(0x195)), Move(uint16_t(0x8DA)), Move(uint16_t(0x14E)), Move(uint16_t(0xE6A)), Move(uint16_t(0xE68)), Move(uint16_t(0x396)), Move(uint16_t(0x6E4)), Move(uint16_t(0x91C)) };
         Move possibleOpeningMoves[MAX_POSSIBLE_OPENING_MOVES];
         uint8_t possibleOpeningMovesAvailable = 0;
         
-        const eval pieceValues[6] = { 100, 300, 320, 500, 900, 9000 };
-        const int8_t pieceSquareTables[7][32] = {
+        static constexpr eval pieceValues[6] = { 100, 300, 320, 500, 900, 9000 };
+        static constexpr int8_t pieceSquareTables[7][32] = {
             { // Pawns
                  0,  0,  0,  0,
                 50, 50, 50, 50,
@@ -127,6 +258,11 @@ namespace Chess {
                 -50,-30,-30,-30
             }
         };
+
+        // The game phase goes from maximumGamePhase with every piece on the board down to zero with only kings and pawns
+        static constexpr uint8_t gamePhaseValues[6] = { 0, 1, 1, 2, 4, 0 };
+        static const uint8_t maximumGamePhase = 24;
+        static const uint8_t endGamePhase = 10;
         const eval aspirationWindowWidth = 50;
         const eval passedPawnBonuses[8] = { 0, 10, 15, 25, 40, 65, 100, 100 };
         const eval passedPawnEndGameBonuses[8] = { 0, 20, 30, 45, 65, 90, 130, 130 };
@@ -141,20 +277,62 @@ namespace Chess {
         const eval castlingBonus = 250;
         const eval castlingAsAnOptionBonus = 50;
         const eval bishopPairBonus = 50;
+        const eval mobilityBonus = 2; // For each square a side attacks
+        const eval kingZoneAttackPenalty = -8; // For each attack on a king or the squares around it, outside the end game
         const eval kingInCornerBonus = 25;
         const eval winingLimit = 50;
         const eval losingLimit = -50;
         const eval kingsTogetherMajorPiecesBonus = 45;
         const eval kingsTogetherMinorPiecesBonus = 3;
         const eval kingsTogetherPawnsBonus = 2;
+        const eval knownWinBonus = 1000;
+        const eval cornerDistanceBonus = 30;
+        const eval kingDistanceBonus = 30;
+        static const uint8_t normalScaleFactor = 16;
         const eval tradingWhileWinningBonus = 50;
         const eval opponentKingMoveBonus = 40;
         const eval pawnBreakBonus = 25;
         const eval pawnMoveBonus = 10;
         const eval forwardMoveBonus = 15;
         const eval randomFactor = 3;
+        const eval lazyEvaluationMargin = 400; // More than every term besides material and piece-square tables can add up to in practice
+        bool randomVariation = true; // When disabled, the same position and seed always produce the same search
 
         const int16_t victimValues[7] = { 100, 200, 300, 400, 500, 600, 0 };
+        const eval hashMoveScore = 5000;
+        const eval killerMoveScores[2] = { 1000, 900 };
+        const eval counterMoveScore = 800;
+        const eval quietCheckScore = 400;
+        static const int16_t maxHistory = 8192; // Every history entry stays within plus or minus this
+        static const int16_t maxHistoryBonus = 1600;
+        const eval goodCaptureScore = 2500;
+        const eval badCaptureScore = -2500; // Below every quiet move
+        const eval deltaPruningMargin = 200;
+        const eval reverseFutilityPruningMargin = 120; // Per ply of depth left
+        const eval razoringMargin = 250; // Per ply of depth left
+        const eval historyPruningMargin = 256; // Per ply of depth left
+        const eval probCutMargin = 200;
+        static const int8_t reverseFutilityPruningDepth = 6;
+        static const int8_t razoringDepth = 3;
+        static const int8_t lateMovePruningDepth = 4;
+        static const uint8_t lateMovePruningMoves = 3; // Plus the square of the depth left
+        static const int8_t historyPruningDepth = 3;
+        static const int8_t probCutDepth = 5;
+        static const int8_t probCutDepthReduction = 4;
+        const eval singularExtensionMargin = 3; // Per ply of depth left
+        static const int8_t singularExtensionDepth = 6;
+        static const int8_t internalIterativeReductionDepth = 4;
+        uint8_t lateMoveReductionTable[16][32]; // By depth left and moves searched so far, both capped to the table
+
+        // Each pruning and reduction technique can be switched off on its own, so its effect can be measured against the rest
+        bool useReverseFutilityPruning = true;
+        bool useRazoring = true;
+        bool useLateMovePruning = true;
+        bool useHistoryPruning = true;
+        bool useProbCut = true;
+        bool useLateMoveReductionTable = true; // Otherwise reduces by one or two plies
+        bool useSingularExtensions = true;
+        bool useInternalIterativeReductions = true;
 
         bool currentlyInEndGame = false;
         clock_t startTime;
@@ -163,44 +341,148 @@ namespace Chess {
         uint8_t startingPly = 0;
         uint8_t searchPly = startingPly;
         uint8_t startingDepth = 0;
-        uint32_t nodes = 0;
-        float failHigh = 0;
-        float failHighFirst = 0;
+
+        // Statistics for the iteration in progress, each completed iteration (indexed by depth - 1), and the whole of the last search
+        SearchStatistics statistics;
+        SearchStatistics* iterationStatistics = nullptr;
+        uint8_t iterationsCompleted = 0;
+        SearchStatistics searchStatistics;
+        bool logSearchStatistics = false; // Writes every iteration and the final totals to the debug console as JSON lines
 
         const clock_t maxThinkTime = 30000;
         const clock_t maxEndGameThinkTime = 30000;
         static const uint8_t minNullDepth = 2;
-        static const uint8_t maximumStandardDepth = 2;
-        static const uint8_t maximumDepth = 6;
-        LegalMoveMemory legalMoveMemory[maximumDepth];
+        uint8_t maximumStandardDepth = 0;
+        uint8_t maximumDepth = 0;
+
+        // Every search stack below is carved out of a single arena that holds maximumDepth plies, so each bot (one per search thread) owns its own stacks.
+        uint8_t* searchStack = nullptr;
+        LegalMoveMemory* legalMoveMemory = nullptr;
+
+        // The transposition table is kept between moves. Each search bumps the generation, so entries from older searches are the first to be replaced.
+        TranspositionEntry transpositionTable[TRANSPOSITION_TABLE_ENTRIES];
+        uint8_t transpositionGeneration = 0;
+        Move* principalVariation = nullptr; // A triangular array, where the row for each ply holds the best line found from that ply onwards
+        uint8_t* principalVariationLength = nullptr;
+
+        // The pawn structure is cached by the board's pawn hash, as it changes far less often than the rest of the position
+        PawnEntry pawnTable[PAWN_TABLE_ENTRIES];
+        MaterialEntry materialTable[MATERIAL_TABLE_ENTRIES]; // Everything that only depends on how many of each piece there are
+        EvaluationEntry evaluationCache[EVALUATION_CACHE_ENTRIES]; // Only holds the part of the evaluation that the hash fully describes, and never the random variation
+
+        PieceToHistory searchHistory;
+        uint16_t counterMoves[12][64]; // The data of the quiet move that last refuted each piece moving to each square
+        Move (*killerMoves)[2] = nullptr;
+#ifndef __TICE__
+        PieceToHistory* continuationHistory = nullptr; // A piece to history for every piece and target of the move before it, over a megabyte so only on host targets
+        bool continuationHistoryIsEmpty = true; // Lets Clear skip the table when nothing was searched since, as positions are often imported in bulk
+#endif
+
+        uint32_t randomState = 1;
 
-        static const uint16_t maxPrincipalVariationEntries = 375;
-        MovePosition principalVariationTable[maxPrincipalVariationEntries];
-        Move principalVariation[maximumDepth];
-        uint16_t indexOfStartPrincipalMove = maxPrincipalVariationEntries;
+#ifndef __TICE__
+        NeuralNetwork network; // Replaces the hand-written evaluation once weights have been loaded
+#endif
 
-        int16_t searchHistory[12][64];
-        Move killerMoves[2][maximumDepth];
+        bool SetDepthLimits (uint8_t standardDepth, uint8_t depth);
+        void InitializeLateMoveReductionTable ();
+#ifndef __TICE__
+        uint32_t Bench (const uint8_t depth); // Searches a fixed set of positions to the depth and returns the total nodes, which changes whenever the search does. Replaces the game on the board.
+#endif
+        void SetRandomSeed (uint32_t seed);
+        inline uint32_t Random ();
 
         inline void ClearPrincipalVariation ();
-        inline void StoreMoveInPrincipalVariationTable (const Move& move, const hash& zobristHash);
-        inline Move ProbePrincipalVariationTable (const hash& zobristHash);
+        inline void StoreInTranspositionTable (const Move& move, const hash& zobristHash, const eval evaluation, const int8_t depth, const uint8_t bound);
+        inline TranspositionEntry* ProbeTranspositionTable (const hash& zobristHash);
+        inline eval FromTranspositionEvaluation (const eval evaluation);
         inline Move ProbeOpeningsTable (const hash& zobristHash);
-        inline bool DoesMoveExist (const Move& move);
-        inline uint8_t GetPrincipalVariation (const uint8_t depth);
+        inline Move* GetPrincipalVariation (const uint8_t ply);
+        inline void UpdatePrincipalVariation (const Move& move);
         inline void CheckIfTimeIsUp ();
         Move Think ();
-        eval Search (int8_t depth, eval alpha = LOWEST_EVALUATION, eval beta = HIGHEST_EVALUATION, bool doNullMove = true);
-        eval QuiescentSearch (eval alpha, eval beta);
+        /**
+         * The search is compiled once for each kind of node, so root only and principal variation only work costs nothing in the null
+         * window nodes that make up most of the tree, and pruning that only applies to those nodes is known at compile time
+         */
+        enum NodeType : uint8_t {
+            rootNode,
+            principalVariationNode,
+            nonPrincipalVariationNode
+        };
+
+        template <NodeType nodeType> eval Search (int8_t depth, eval alpha, eval beta, bool doNullMove = true);
+        template <NodeType nodeType> eval QuiescentSearch (eval alpha, eval beta);
         inline void SetNextMove (Move* moves, eval* scores, uint8_t availableMoves, uint8_t currentIndex);
-        inline void ScoreMoves (Move* moves, eval* scores, uint8_t availableMoves);
-        eval Evaluate ();
+        inline void InitializeMovePicker (LegalMoveMemory& memory, const Move& principalMove, const bool onlyCaptures);
+        bool PickNextMove (LegalMoveMemory& memory, Move& move, eval& score);
+        inline void ScoreMoves (Move* moves, eval* scores, uint8_t availableMoves, const LegalMoveMemory& memory);
+        inline Move GetPreviousMove (const uint8_t plies);
+        inline eval GetQuietHistory (const LegalMoveMemory& memory, const Move& move);
+        inline void UpdateQuietHistories (const LegalMoveMemory& memory, const Move& move, const int16_t bonus);
+        inline void UpdateHistory (int16_t& entry, const int16_t bonus);
+        eval StaticExchangeEvaluation (const Move& move);
+        inline uint8_t GetLeastValuableAttacker (const uint8_t square, const piece side, const uint64_t removedSquares);
+        eval Evaluate (const eval alpha = LOWEST_EVALUATION, const eval beta = HIGHEST_EVALUATION);
+        eval EvaluatePosition (const bool isEndGame);
+        template <piece side> inline eval EvaluateRooksBehindPassedPawns (const uint8_t file, const uint8_t rearmostPassedPawn);
+        inline eval EvaluateGameHistory (eval evaluation, const bool isEndGame);
+#ifndef __TICE__
+        bool LoadNeuralNetwork (const char* fileName);
+        eval EvaluateNeuralNetwork ();
+        bool EvaluateBatch (const char* const* positions, const uint32_t numberOfPositions, eval* evaluations);
+#endif
+        inline PawnEntry& ProbePawnTable ();
+        void EvaluatePawnStructure (PawnEntry& entry);
+        MaterialEntry& ProbeMaterialTable ();
+        void EvaluateMaterial (MaterialEntry& entry);
+        eval EvaluateEndGame (const MaterialEntry& entry);
+        inline uint8_t GetCenterDistance (const uint8_t square);
+        inline uint8_t GetDistance (const uint8_t square, const uint8_t otherSquare);
+        inline uint8_t GetKingZoneAttacks (const uint8_t kingSquare, const piece attackingSide);
         inline eval MaterialAdvantage ();
         inline bool IsEndGame ();
+        inline void AgeSearchHeuristics ();
         void Clear ();
 
         Bot (Board* _board) {
             board = _board;
+            SetDepthLimits(DEFAULT_MAXIMUM_STANDARD_DEPTH, DEFAULT_MAXIMUM_DEPTH);
+            SetRandomSeed(rtc_Time());
+            InitializeLateMoveReductionTable();
+#ifndef __TICE__
+            continuationHistory = (PieceToHistory*)calloc(12 * 64, sizeof(PieceToHistory));
+#endif
+        }
+
+        ~Bot () {
+            free(searchStack);
+#ifndef __TICE__
+            free(continuationHistory);
+#endif
         }
     };
+
+    // Material and piece-square values of every piece on every square, negative for black. They're generated at compile time from the bot's half-board tables so the board can keep a running evaluation as pieces are placed.
+    struct PieceSquareValues {
+        eval middleGame[12][64] = {};
+        eval endGame[12][64] = {};
+
+        constexpr PieceSquareValues () {
+            for (uint8_t index = 0; index < 6; index++) {
+                for (uint8_t square = 0; square < 64; square++) {
+                    const uint8_t rank = square / 8;
+                    const uint8_t file = square % 8 < 4 ? square % 8 : 7 - square % 8;
+                    const uint8_t endGameIndex = index == Piece::king - 1 ? index + 1 : index;
+
+                    middleGame[index][square] = -(Bot::pieceValues[index] + Bot::pieceSquareTables[index][(7 - rank) * 4 + file]);
+                    middleGame[index + 6][square] = Bot::pieceValues[index] + Bot::pieceSquareTables[index][rank * 4 + file];
+                    endGame[index][square] = -(Bot::pieceValues[index] + Bot::pieceSquareTables[endGameIndex][(7 - rank) * 4 + file]);
+                    endGame[index + 6][square] = Bot::pieceValues[index] + Bot::pieceSquareTables[endGameIndex][rank * 4 + file];
+                }
+            }
+        }
+    };
+
+    inline constexpr PieceSquareValues pieceSquareValues;
 }
\ No newline at end of file
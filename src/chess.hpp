@@ -15,10 +15,12 @@
 #include <keypadc.h>
 #include <ti/getcsc.h>
 #include <time.h>
+#include <stdlib.h>
 #include <fileioc.h>
 #include <sys/rtc.h>
 #include <sys/util.h>
 #include <cmath>
+#include <new>
 #include <compression.h>
 #include <debug.h>
 
@@ -28,7 +30,10 @@
 #include "utils.hpp"
 #include "option.hpp"
 #include "piece.hpp"
+#include "tables.hpp"
 #include "move.hpp"
 #include "statistics.hpp"
+#include "nnue.hpp"
 #include "bot.hpp"
+#include "batch.hpp"
 #include "board.hpp"
\ No newline at end of file
@@ -92,6 +92,28 @@
 #define OPENING_POSITIONS 149
 #define MAX_POSSIBLE_OPENING_MOVES 10
 
+// Search depth limits in plies. The calculator's heap only fits a handful of search plies, while host targets can afford far deeper stacks.
+#ifdef __TICE__
+#define DEFAULT_MAXIMUM_STANDARD_DEPTH 2
+#define DEFAULT_MAXIMUM_DEPTH 6
+#define MAX_SEARCH_DEPTH 16
+#define TRANSPOSITION_TABLE_ENTRIES 375
+#define PAWN_TABLE_ENTRIES 128
+#define EVALUATION_CACHE_ENTRIES 256
+#define MATERIAL_TABLE_ENTRIES 32
+#else
+#define DEFAULT_MAXIMUM_STANDARD_DEPTH 32
+#define DEFAULT_MAXIMUM_DEPTH 64
+#define MAX_SEARCH_DEPTH 120 // Under the int8_t limit, so the standard depth keeps some room for extensions
+#define TRANSPOSITION_TABLE_ENTRIES (1 << 20)
+#define PAWN_TABLE_ENTRIES 8192
+#define EVALUATION_CACHE_ENTRIES 16384
+#define MATERIAL_TABLE_ENTRIES 1024
+#endif
+
+// Mates are scored as HIGHEST_EVALUATION less the plies it takes to get there, so anything past this, which no search can reach otherwise, is a forced mate
+#define MATE_EVALUATION_THRESHOLD (HIGHEST_EVALUATION - MAX_SEARCH_DEPTH)
+
 #define IDENTIFIER_SIZE 5
 
 #define FILE_SUCCESS 1
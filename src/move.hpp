@@ -64,7 +64,7 @@ namespace Chess {
         static inline bool IsThisPromotion (const Move& move, const uint8_t promotion) { return (move.data & inverseCaptureMask) >> 12 == promotion; }
         static inline bool IsNullMove (const Move& move) { return move.data == 0 || move.pieceMoved == 0; }
 
-        static inline bool IsEqual (const Move& moveToCompare, const Move& moveToReference) { return moveToCompare.data == moveToReference.data && moveToCompare.pieceMoved == moveToReference.pieceMoved && moveToCompare.pieceCaptured == moveToReference.pieceCaptured && moveToCompare.check == moveToReference.check; };
+        static inline bool IsEqual (const Move& moveToCompare, const Move& moveToReference) { return moveToCompare.data == moveToReference.data && moveToCompare.pieceMoved == moveToReference.pieceMoved && moveToCompare.pieceCaptured == moveToReference.pieceCaptured; }; // Whether a move checks follows from the position, so it isn't compared
 
         Move () {}
         Move (const uint16_t _data) : data(_data) {}
@@ -0,0 +1,154 @@
+/**
+ * @file nnue.cpp
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Definition of the efficiently updatable neural network evaluation
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "chess.hpp"
+
+#ifndef __TICE__
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace Chess {
+    bool NeuralNetwork::Load (const char* fileName) {
+        Unload();
+
+        FILE* file = fopen(fileName, "rb");
+        if (file == nullptr) return false;
+
+        char magic[4];
+        uint32_t fileVersion, fileHiddenSize;
+        bool isValid = fread(magic, 1, 4, file) == 4 && memcmp(magic, "NNUE", 4) == 0
+            && fread(&fileVersion, sizeof(fileVersion), 1, file) == 1 && fileVersion == version
+            && fread(&fileHiddenSize, sizeof(fileHiddenSize), 1, file) == 1 && fileHiddenSize == hiddenSize
+            && fread(&outputScale, sizeof(outputScale), 1, file) == 1 && outputScale > 0;
+
+        if (isValid) {
+            featureWeights = (int16_t*)malloc(sizeof(int16_t) * featureCount * hiddenSize);
+
+            isValid = featureWeights != nullptr
+                && fread(featureBiases, sizeof(int16_t), hiddenSize, file) == hiddenSize
+                && fread(featureWeights, sizeof(int16_t), size_t(featureCount) * hiddenSize, file) == size_t(featureCount) * hiddenSize
+                && fread(&outputBias, sizeof(outputBias), 1, file) == 1
+                && fread(outputWeights, sizeof(int8_t), 2 * hiddenSize, file) == 2 * hiddenSize;
+        }
+
+        fclose(file);
+
+        if (!isValid) {
+            Unload();
+            return false;
+        }
+
+        return isLoaded = true;
+    }
+
+    void NeuralNetwork::Unload () {
+        free(featureWeights);
+        featureWeights = nullptr;
+        isLoaded = false;
+    }
+
+    uint32_t NeuralNetwork::GetFeatureIndex (const piece perspective, const uint8_t kingSquare, const piece pieceOnSquare, const uint8_t square) {
+        uint8_t orientation = perspective == Piece::black ? 56 : 0;
+        uint8_t pieceType = Piece::GetPiece(pieceOnSquare) - 1 + (Piece::IsSide(pieceOnSquare, perspective) ? 0 : 5);
+
+        return (uint32_t((kingSquare ^ orientation)) * pieceTypes + pieceType) * 64 + (square ^ orientation);
+    }
+
+    void NeuralNetwork::AddFeature (int16_t* accumulator, const uint32_t feature) const {
+        const int16_t* column = featureWeights + size_t(feature) * hiddenSize;
+
+#if defined(__AVX2__)
+        for (uint16_t i = 0; i < hiddenSize; i += 16) _mm256_store_si256((__m256i*)(accumulator + i), _mm256_add_epi16(_mm256_load_si256((const __m256i*)(accumulator + i)), _mm256_loadu_si256((const __m256i*)(column + i))));
+#elif defined(__SSE4_1__)
+        for (uint16_t i = 0; i < hiddenSize; i += 8) _mm_store_si128((__m128i*)(accumulator + i), _mm_add_epi16(_mm_load_si128((const __m128i*)(accumulator + i)), _mm_loadu_si128((const __m128i*)(column + i))));
+#else
+        for (uint16_t i = 0; i < hiddenSize; i++) accumulator[i] += column[i];
+#endif
+    }
+
+    void NeuralNetwork::SubtractFeature (int16_t* accumulator, const uint32_t feature) const {
+        const int16_t* column = featureWeights + size_t(feature) * hiddenSize;
+
+#if defined(__AVX2__)
+        for (uint16_t i = 0; i < hiddenSize; i += 16) _mm256_store_si256((__m256i*)(accumulator + i), _mm256_sub_epi16(_mm256_load_si256((const __m256i*)(accumulator + i)), _mm256_loadu_si256((const __m256i*)(column + i))));
+#elif defined(__SSE4_1__)
+        for (uint16_t i = 0; i < hiddenSize; i += 8) _mm_store_si128((__m128i*)(accumulator + i), _mm_sub_epi16(_mm_load_si128((const __m128i*)(accumulator + i)), _mm_loadu_si128((const __m128i*)(column + i))));
+#else
+        for (uint16_t i = 0; i < hiddenSize; i++) accumulator[i] -= column[i];
+#endif
+    }
+
+    void NeuralNetwork::ResetAccumulator (int16_t* accumulator) const {
+        memcpy(accumulator, featureBiases, sizeof(featureBiases));
+    }
+
+    int32_t NeuralNetwork::Propagate (const int16_t* sideToMoveAccumulator, const int16_t* opponentAccumulator) const {
+        int32_t sum = 0;
+        const int16_t* accumulators[2] = { sideToMoveAccumulator, opponentAccumulator };
+
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i limit = _mm256_set1_epi16(activationLimit);
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i total = _mm256_setzero_si256();
+
+        for (uint8_t perspective = 0; perspective < 2; perspective++) {
+            for (uint16_t i = 0; i < hiddenSize; i += 32) {
+                __m256i low = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(accumulators[perspective] + i)), zero), limit);
+                __m256i high = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(accumulators[perspective] + i + 16)), zero), limit);
+                // Packing works within each 128-bit lane, so the quarters have to be put back in order to line up with the weights
+                __m256i activations = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+                __m256i products = _mm256_maddubs_epi16(activations, _mm256_load_si256((const __m256i*)(outputWeights + perspective * hiddenSize + i)));
+                total = _mm256_add_epi32(total, _mm256_madd_epi16(products, ones));
+            }
+        }
+
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+        sum = _mm_cvtsi128_si32(half);
+#elif defined(__SSE4_1__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i limit = _mm_set1_epi16(activationLimit);
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i total = _mm_setzero_si128();
+
+        for (uint8_t perspective = 0; perspective < 2; perspective++) {
+            for (uint16_t i = 0; i < hiddenSize; i += 16) {
+                __m128i low = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(accumulators[perspective] + i)), zero), limit);
+                __m128i high = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(accumulators[perspective] + i + 8)), zero), limit);
+                __m128i products = _mm_maddubs_epi16(_mm_packus_epi16(low, high), _mm_load_si128((const __m128i*)(outputWeights + perspective * hiddenSize + i)));
+                total = _mm_add_epi32(total, _mm_madd_epi16(products, ones));
+            }
+        }
+
+        total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0x4E));
+        total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0xB1));
+        sum = _mm_cvtsi128_si32(total);
+#else
+        for (uint8_t perspective = 0; perspective < 2; perspective++) {
+            for (uint16_t i = 0; i < hiddenSize; i++) {
+                int16_t activation = accumulators[perspective][i] < 0 ? 0 : accumulators[perspective][i] > activationLimit ? activationLimit : accumulators[perspective][i];
+                sum += activation * outputWeights[perspective * hiddenSize + i];
+            }
+        }
+#endif
+
+        return (sum + outputBias) / outputScale;
+    }
+}
+
+#endif
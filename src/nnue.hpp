@@ -0,0 +1,63 @@
+/**
+ * @file nnue.hpp
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Declaration of the efficiently updatable neural network evaluation
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+// The network's weights alone are several megabytes, so it is only available on host targets and the calculator keeps the hand-written evaluation
+#ifndef __TICE__
+
+namespace Chess {
+    /**
+     * Network layout: king relative piece square features (the side's king square, one of ten non-king pieces, and the square it's on) feed a
+     * hidden layer per perspective, stored as 16-bit accumulators. Both accumulators, side to move first, are clipped to 0-127 and fed through
+     * 8-bit output weights into a single evaluation in centipawns.
+     *
+     * Weight file format (little endian): "NNUE", uint32 version, uint32 hidden size, int32 output scale, int16 feature biases[hidden size],
+     * int16 feature weights[feature count][hidden size], int32 output bias, int8 output weights[2 * hidden size].
+     */
+    struct NeuralNetwork {
+        static const uint32_t version = 1;
+        static const uint16_t hiddenSize = 256;
+        static const uint16_t kingSquares = 64;
+        static const uint8_t pieceTypes = 10;
+        static const uint32_t featureCount = kingSquares * pieceTypes * 64;
+        static const int16_t activationLimit = 127;
+
+        int16_t* featureWeights = nullptr; // featureCount by hiddenSize
+        alignas(32) int16_t featureBiases[hiddenSize];
+        alignas(32) int8_t outputWeights[2 * hiddenSize];
+        int32_t outputBias = 0;
+        int32_t outputScale = 1;
+        bool isLoaded = false;
+
+        ~NeuralNetwork () { Unload(); }
+
+        bool Load (const char* fileName);
+        void Unload ();
+
+        /**
+         * Features are seen from each side's point of view, so black's squares are mirrored vertically and its own pieces come first for both sides
+         */
+        static uint32_t GetFeatureIndex (const piece perspective, const uint8_t kingSquare, const piece pieceOnSquare, const uint8_t square);
+
+        void AddFeature (int16_t* accumulator, const uint32_t feature) const;
+        void SubtractFeature (int16_t* accumulator, const uint32_t feature) const;
+        void ResetAccumulator (int16_t* accumulator) const;
+        int32_t Propagate (const int16_t* sideToMoveAccumulator, const int16_t* opponentAccumulator) const;
+    };
+
+    struct NeuralNetworkAccumulator {
+        alignas(32) int16_t values[2][NeuralNetwork::hiddenSize]; // 0 = black's perspective, 1 = white's perspective
+        bool isStale[2] = { true, true }; // A perspective has to be recomputed from scratch once its king moves, as every feature depends on it
+    };
+}
+
+#endif
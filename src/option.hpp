@@ -58,7 +58,10 @@ namespace Chess {
             ResetBlackStatistics,
             ResetAll,
             UpdateResetBoardOn,
-            ViewHelp
+            ViewHelp,
+            UpdateSearchDepth,
+            UpdateMaximumDepth,
+            UpdateRandomVariation
         };
 
         const char* names[3];
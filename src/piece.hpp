@@ -53,5 +53,24 @@ namespace Chess {
         char GetPieceName (piece pieceToCompare, const bool ignoreSide = false);
 
         inline uint8_t GetLinearValue (const piece pieceToReference) { return pieceToReference - 9 - (IsSide(pieceToReference, white) ? 2 : 0); }
+
+        /**
+         * Everything about a side that moving its pieces depends on, as constants, so code templated on the side doesn't branch on it.
+         * Ranks count rows from the top of the board, like the squares do.
+         */
+        template <piece side> struct SideTraits {
+            static constexpr piece opposite = side == white ? black : white;
+            static constexpr piece pawn = side | Piece::pawn;
+            static constexpr piece rook = side | Piece::rook;
+            static constexpr piece king = side | Piece::king;
+            static constexpr int8_t forward = side == white ? -8 : 8; // One rank towards the opponent
+            static constexpr uint8_t pawnStartRank = side == white ? 6 : 1;
+            static constexpr uint8_t promotionRank = side == white ? 0 : 7;
+            static constexpr uint8_t backRank = side == white ? 7 : 0;
+            static constexpr uint8_t kingRookStart = side == white ? H1 : H8;
+            static constexpr uint8_t kingRookTarget = side == white ? F1 : F8;
+            static constexpr uint8_t queenRookStart = side == white ? A1 : A8;
+            static constexpr uint8_t queenRookTarget = side == white ? D1 : D8;
+        };
     }
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * @file tables.hpp
+ * @author Warren James (thewarrenjames@gmail.com)
+ * @brief Declaration of the attack and hash key tables
+ * @version 1.0.0
+ * @date 2025-06-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+namespace Chess {
+    // Where each piece can reach from each square on an empty board, with the sliders' rays and the line joining any two squares. They're generated at compile time into read-only storage, so nothing is worked out at startup and the move generators only look them up.
+    struct AttackTables {
+        // File and rank steps, with the diagonal directions first and then the orthogonal ones.
+        static constexpr int8_t knightOffsets[8][2] = { { 1, -2 }, { 2, -1 }, { 2, 1 }, { 1, 2 }, { -1, 2 }, { -2, 1 }, { -2, -1 }, { -1, -2 } };
+        static constexpr int8_t directions[8][2] = { { 1, -1 }, { 1, 1 }, { -1, 1 }, { -1, -1 }, { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+        static constexpr int8_t directionSteps[8] = { -7, 9, 7, -9, -8, 1, 8, -1 }; // The same directions as square offsets
+        static constexpr uint8_t noDirection = 8;
+
+        uint64_t knightAttacks[64] = {};
+        uint64_t kingAttacks[64] = {};
+        uint64_t pawnAttacks[2][64] = {}; // The squares a pawn of either side (0 = black, 1 = white) attacks from each square
+        uint8_t knightTargets[64][8] = {}; // The same squares as the masks, listed for the mailbox generators
+        uint8_t knightTargetCounts[64] = {};
+        uint8_t kingTargets[64][8] = {};
+        uint8_t kingTargetCounts[64] = {};
+        uint8_t rayLengths[8][64] = {}; // How many squares there are in each direction before the edge of the board
+        uint8_t lineDirections[64][64] = {}; // The direction from the first square to the second, or noDirection if they don't share a rank, file or diagonal
+
+        constexpr AttackTables () {
+            for (uint8_t square = 0; square < 64; square++) {
+                const int8_t file = square % 8;
+                const int8_t rank = square / 8;
+
+                for (uint8_t target = 0; target < 64; target++) lineDirections[square][target] = noDirection;
+
+                for (uint8_t i = 0; i < 8; i++) {
+                    const int8_t knightFile = file + knightOffsets[i][0], knightRank = rank + knightOffsets[i][1];
+                    if (knightFile >= 0 && knightFile < 8 && knightRank >= 0 && knightRank < 8) {
+                        knightAttacks[square] |= uint64_t(1) << (knightRank * 8 + knightFile);
+                        knightTargets[square][knightTargetCounts[square]++] = knightRank * 8 + knightFile;
+                    }
+
+                    int8_t targetFile = file + directions[i][0], targetRank = rank + directions[i][1];
+                    if (targetFile >= 0 && targetFile < 8 && targetRank >= 0 && targetRank < 8) {
+                        kingAttacks[square] |= uint64_t(1) << (targetRank * 8 + targetFile);
+                        kingTargets[square][kingTargetCounts[square]++] = targetRank * 8 + targetFile;
+                    }
+
+                    for (; targetFile >= 0 && targetFile < 8 && targetRank >= 0 && targetRank < 8; targetFile += directions[i][0], targetRank += directions[i][1]) {
+                        rayLengths[i][square]++;
+                        lineDirections[square][targetRank * 8 + targetFile] = i;
+                    }
+                }
+
+                // White pawns attack up the board, towards the lower squares
+                for (int8_t pawnFile = file - 1; pawnFile <= file + 1; pawnFile += 2) {
+                    if (pawnFile < 0 || pawnFile > 7) continue;
+                    if (rank < 7) pawnAttacks[0][square] |= uint64_t(1) << ((rank + 1) * 8 + pawnFile);
+                    if (rank > 0) pawnAttacks[1][square] |= uint64_t(1) << ((rank - 1) * 8 + pawnFile);
+                }
+            }
+        }
+    };
+
+    inline constexpr AttackTables attackTables;
+
+    // SplitMix64, which spreads a simple counter over all 64 bits well enough for hash keys and is simple enough to run at compile time
+    constexpr uint64_t NextZobristKey (uint64_t& state) {
+        uint64_t key = state += 0x9E3779B97F4A7C15;
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EB;
+        return key ^ (key >> 31);
+    }
+
+    // Generated at compile time like the attack tables. The calculator's hash only keeps the low half of each key, which XORs together the same way.
+    struct ZobristKeys {
+        hash pieceData[64][13] = {}; // Each linear piece value on each square, then the en passant square. The material hash reuses these with piece counts in place of squares.
+        hash sideToMove = 0;
+        hash castleRights[16] = {};
+
+        constexpr ZobristKeys () {
+            uint64_t state = 0x43484553533834; // "CHESS84"
+
+            for (uint8_t square = 0; square < 64; square++) for (uint8_t index = 0; index < 13; index++) pieceData[square][index] = hash(NextZobristKey(state));
+            sideToMove = hash(NextZobristKey(state));
+            for (uint8_t rights = 0; rights < 16; rights++) castleRights[rights] = hash(NextZobristKey(state));
+        }
+    };
+
+    inline constexpr ZobristKeys zobristKeys;
+}
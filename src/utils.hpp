@@ -24,7 +24,12 @@ namespace Chess {
 
     extern gfx_sprite_t* sprites[NUMBER_OF_SPRITES];
 
+    // 64-bit arithmetic is emulated on the calculator, so it only keeps the low half of each Zobrist key
+#ifdef __TICE__
     typedef uint32_t hash;
+#else
+    typedef uint64_t hash;
+#endif
     typedef int16_t eval;
 
     bool StringCompare (const char* string1, const char* string2);